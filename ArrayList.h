@@ -0,0 +1,527 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ListIndex.h"
+#include "ListStorage.h"
+
+/*
+ A list that keeps its data pointers in one contiguous array. It has the
+ same interface as the linked List, but peek and setData take O(1) time and
+ traversals are prefetch-friendly. Insertion and removal at the end take
+ amortized O(1) time; anywhere else they move the later elements.
+
+ Use it as List<T, ContiguousStorage>, or through the ArrayList<T> alias.
+ */
+template <typename T>
+class List<T, ContiguousStorage> {
+
+protected:
+
+    /*
+     The data pointers, in list order.
+     */
+    std::vector<T*> items;
+
+    /*
+     sort only uses another thread for each slice of at least this many
+     elements.
+     */
+    static const int minimumSortSlice = 1 << 15;
+
+    /*
+     Optional hash index from data pointers to positions, used by getIndex.
+     See List::enableIndex.
+     */
+    std::unique_ptr<ListIndex<T>> index;
+    int indexThreshold;
+
+    /*
+     Marks the index, if there is one, as out of date.
+     */
+    void invalidateIndex() {
+        if (this->index != nullptr) {
+            this->index->invalidate();
+        }
+    }
+
+public:
+
+    typedef typename std::vector<T*>::iterator Iterator;
+    typedef Iterator iterator;
+    typedef typename std::vector<T*>::reverse_iterator ReverseIterator;
+    typedef ReverseIterator reverse_iterator;
+
+    /*
+     Creates an empty list.
+     */
+    List() {
+        this->indexThreshold = -1;
+    }
+
+    /*
+     Creates a list holding the same data pointers as the specified one. The
+     copy builds its own index on first use.
+     */
+    List(const List<T, ContiguousStorage>& other) : items(other.items) {
+        this->indexThreshold = other.indexThreshold;
+    }
+
+    /*
+     Creates a list that takes over the elements and index of the specified
+     one, leaving it empty.
+     */
+    List(List<T, ContiguousStorage>&& other) : items(std::move(other.items)), index(std::move(other.index)) {
+        this->indexThreshold = other.indexThreshold;
+        other.items.clear();
+    }
+
+    List<T, ContiguousStorage>& operator=(const List<T, ContiguousStorage>& other) {
+        if (this != &other) {
+            this->items = other.items;
+            this->indexThreshold = other.indexThreshold;
+            this->index.reset();
+        }
+        return *this;
+    }
+
+    List<T, ContiguousStorage>& operator=(List<T, ContiguousStorage>&& other) {
+        if (this != &other) {
+            this->items = std::move(other.items);
+            this->indexThreshold = other.indexThreshold;
+            this->index = std::move(other.index);
+            other.items.clear();
+        }
+        return *this;
+    }
+
+    /*
+     Removes every element from this list. The data is left alone.
+     */
+    void clear() {
+        this->items.clear();
+        this->index.reset();
+    }
+
+    /*
+     Creates a list containing the specified data, in order.
+     */
+    List(std::initializer_list<T*> items) : List() {
+        this->insertRange(0, items.begin(), items.end());
+    }
+
+    /*
+     Creates a list containing the data in the range [first, last), in
+     order.
+     */
+    template <typename InputIterator>
+    List(InputIterator first, InputIterator last) : List() {
+        this->insertRange(0, first, last);
+    }
+
+    /*
+     Makes room for at least the specified number of elements, so that
+     appending up to that many causes no reallocation.
+     */
+    void reserve(int numElements) {
+        if (numElements > 0) {
+            this->items.reserve(static_cast<std::size_t>(numElements));
+        }
+    }
+
+    /*
+     Inserts the data in the range [first, last) into this list, in order,
+     starting at the specified position, with at most one reallocation.
+     Positions are clamped as in insertAtPosition.
+     */
+    template <typename InputIterator>
+    void insertRange(int position, InputIterator first, InputIterator last) {
+        if (position >= this->getSize()) {
+            int oldSize = this->getSize();
+            this->items.insert(this->items.end(), first, last);
+            if (this->index != nullptr) {
+                for (int k = oldSize; k < this->getSize(); k++) {
+                    this->index->insertedAtEnd(this->items[k], k);
+                }
+            }
+        }
+        else {
+            if (position < 0) {
+                position = 0;
+            }
+            this->invalidateIndex();
+            this->items.insert(this->items.begin() + position, first, last);
+        }
+    }
+
+    /*
+     Enables the hash index used by getIndex, once this list has at least
+     the specified number of elements.
+     */
+    void enableIndex(int minimumSize = 0) {
+        this->indexThreshold = minimumSize < 0 ? 0 : minimumSize;
+    }
+
+    /*
+     Disables the hash index and releases its memory.
+     */
+    void disableIndex() {
+        this->indexThreshold = -1;
+        this->index.reset();
+    }
+
+    /*
+     Returns true if and only if indexing is enabled for this list.
+     */
+    bool isIndexed() {
+        return this->indexThreshold >= 0;
+    }
+
+    /*
+     Returns true if and only if this list has no elements.
+     */
+    bool isEmpty() {
+        return this->items.empty();
+    }
+
+    /*
+     Returns the number of elements in this list.
+     */
+    int getSize() {
+        return static_cast<int>(this->items.size());
+    }
+
+    /*
+     Returns the data at the specified position of this list, or the null
+     pointer if the position does not exist in this list.
+     */
+    T* peek(int position) {
+        T* result = nullptr;
+        if (position >= 0 && position < this->getSize()) {
+            result = this->items[position];
+        }
+        return result;
+    }
+
+    /*
+     Sets the data in the specified position. If the position does not
+     exist in this list, this method does nothing.
+     */
+    void setData(T* data, int position) {
+        if (position >= 0 && position < this->getSize()) {
+            this->invalidateIndex();
+            this->items[position] = data;
+        }
+    }
+
+    /*
+     Inserts the specified data at the beginning of this list.
+     */
+    void insertAtStart(T* data) {
+        this->items.insert(this->items.begin(), data);
+        if (this->index != nullptr) {
+            this->index->insertedAtStart(data);
+        }
+    }
+
+    /*
+     Inserts the specified data at the end of this list.
+     */
+    void insertAtEnd(T* data) {
+        this->items.push_back(data);
+        if (this->index != nullptr) {
+            this->index->insertedAtEnd(data, this->getSize() - 1);
+        }
+    }
+
+    /*
+     Removes the first element of this list, and returns its data.
+     */
+    T* removeFromStart() {
+        T* result = nullptr;
+        if (!this->isEmpty()) {
+            result = this->items.front();
+            this->items.erase(this->items.begin());
+            if (this->index != nullptr) {
+                this->index->removedFromStart(result);
+            }
+        }
+        return result;
+    }
+
+    /*
+     Removes the last element of this list, and returns its data.
+     */
+    T* removeFromEnd() {
+        T* result = nullptr;
+        if (!this->isEmpty()) {
+            result = this->items.back();
+            this->items.pop_back();
+            if (this->index != nullptr) {
+                this->index->removedFromEnd(result);
+            }
+        }
+        return result;
+    }
+
+    /*
+     Returns the index of the first occurance of the specified data in this
+     list, or a negative number if the data is not in this list.
+     */
+    int getIndex(T* data) {
+        if (this->index == nullptr && this->isIndexed() && this->getSize() >= this->indexThreshold) {
+            this->index.reset(new ListIndex<T>());
+        }
+        if (this->index != nullptr) {
+            if (this->index->isStale() && this->index->rebuildDue()) {
+                this->index->rebuild(this->begin(), this->end());
+            }
+            if (!this->index->isStale()) {
+                return this->index->find(data);
+            }
+        }
+        int result = -1;
+        int sz = this->getSize();
+        for (int k = 0; k < sz; k++) {
+            if (this->items[k] == data) {
+                result = k;
+                break;
+            }
+        }
+        return result;
+    }
+
+    /*
+     Removes the element at the specified position, and returns its data.
+     If there is no element in the specified position, this method leaves
+     the list unaltered and returns the null pointer.
+     */
+    T* removeFromPosition(int position) {
+        T* result;
+        if (position < 0 || position >= this->getSize()) {
+            result = nullptr;
+        }
+        else if (position == 0) {
+            result = this->removeFromStart();
+        }
+        else if (position == this->getSize() - 1) {
+            result = this->removeFromEnd();
+        }
+        else {
+            this->invalidateIndex();
+            result = this->items[position];
+            this->items.erase(this->items.begin() + position);
+        }
+        return result;
+    }
+
+    /*
+     Inserts the specified data into the list in the specified position.
+     Positions before the start of the list insert at the start, and
+     positions after the end insert at the end.
+     */
+    void insertAtPosition(int position, T* data) {
+        if (position <= 0) {
+            this->insertAtStart(data);
+        }
+        else if (position >= this->getSize()) {
+            this->insertAtEnd(data);
+        }
+        else {
+            this->invalidateIndex();
+            this->items.insert(this->items.begin() + position, data);
+        }
+    }
+
+    /*
+     Splits this list after the specified position, removing all elements
+     after that position from this list, and returning them as another list.
+     */
+    List<T, ContiguousStorage>* splitAfter(int position) {
+        List<T, ContiguousStorage>* result = new List<T, ContiguousStorage>();
+        if (position >= 0 && position < this->getSize() - 1) {
+            this->invalidateIndex();
+            result->items.assign(this->items.begin() + position + 1, this->items.end());
+            this->items.resize(position + 1);
+        }
+        return result;
+    }
+
+    /*
+     Appends the elements of the specified list to this one, leaving the
+     specified list empty.
+     */
+    void append(List<T, ContiguousStorage>* suffix) {
+        if (!suffix->isEmpty()) {
+            this->invalidateIndex();
+            this->items.insert(this->items.end(), suffix->items.begin(), suffix->items.end());
+            suffix->items.clear();
+            suffix->invalidateIndex();
+        }
+    }
+
+    /*
+     Prepends the elements of the specified list to this one, leaving the
+     specified list empty.
+     */
+    void prepend(List<T, ContiguousStorage>* prefix) {
+        if (!prefix->isEmpty()) {
+            this->invalidateIndex();
+            this->items.insert(this->items.begin(), prefix->items.begin(), prefix->items.end());
+            prefix->items.clear();
+            prefix->invalidateIndex();
+        }
+    }
+
+    /*
+     Removes every element whose data satisfies the specified predicate, a
+     function object taking a T* and returning bool, in a single pass over
+     this list. The remaining elements keep their order. Returns the number
+     of elements removed.
+     */
+    template <typename Predicate>
+    int removeIf(Predicate predicate) {
+        typename std::vector<T*>::iterator kept = std::remove_if(this->items.begin(), this->items.end(), predicate);
+        int numRemoved = static_cast<int>(this->items.end() - kept);
+        if (numRemoved > 0) {
+            this->items.erase(kept, this->items.end());
+            this->invalidateIndex();
+        }
+        return numRemoved;
+    }
+
+    /*
+     Removes every occurrence of the specified data pointer from this list
+     in a single pass, and returns the number removed.
+     */
+    int removeAll(T* data) {
+        return this->removeIf([data](T* item) { return item == data; });
+    }
+
+    /*
+     Removes every element whose data does not satisfy the specified
+     predicate in a single pass, and returns the number removed.
+     */
+    template <typename Predicate>
+    int retainIf(Predicate predicate) {
+        return this->removeIf([&predicate](T* item) { return !predicate(item); });
+    }
+
+    /*
+     Sorts this list by the data its elements point to, using the specified
+     ordering over T (a strict weak ordering, like std::less<T>). The sort
+     is stable and takes O(n log n) time.
+
+     A large list is cut into one slice per hardware thread; the slices are
+     sorted on their own threads and then merged pairwise, also in
+     parallel. The ordering must therefore be safe to call from several
+     threads at once.
+     */
+    template <typename Compare>
+    void sort(Compare less) {
+        auto byData = [&less](T* a, T* b) { return less(*a, *b); };
+        int numSlices = static_cast<int>(std::thread::hardware_concurrency());
+        if (numSlices > this->getSize() / minimumSortSlice) {
+            numSlices = this->getSize() / minimumSortSlice;
+        }
+        if (numSlices < 2) {
+            std::stable_sort(this->items.begin(), this->items.end(), byData);
+        }
+        else {
+            std::vector<Iterator> bounds;
+            for (int k = 0; k <= numSlices; k++) {
+                bounds.push_back(this->items.begin() + static_cast<long long>(this->items.size()) * k / numSlices);
+            }
+            std::vector<std::thread> workers;
+            for (int k = 0; k < numSlices; k++) {
+                workers.emplace_back([&bounds, &byData, k]() {
+                    std::stable_sort(bounds[k], bounds[k + 1], byData);
+                });
+            }
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+            // merge neighbouring runs, doubling their length each round
+            for (int width = 1; width < numSlices; width *= 2) {
+                workers.clear();
+                for (int k = 0; k + width < numSlices; k += 2 * width) {
+                    int last = std::min(k + 2 * width, numSlices);
+                    workers.emplace_back([&bounds, &byData, k, width, last]() {
+                        std::inplace_merge(bounds[k], bounds[k + width], bounds[last], byData);
+                    });
+                }
+                for (std::thread& worker : workers) {
+                    worker.join();
+                }
+            }
+        }
+        this->invalidateIndex();
+    }
+
+    /*
+     Sorts this list by the data its elements point to, in ascending order.
+     */
+    void sort() {
+        this->sort(std::less<T>());
+    }
+
+    /*
+     Returns an iterator positioned at the first element of this list.
+     */
+    Iterator begin() {
+        return this->items.begin();
+    }
+
+    /*
+     Returns the past-the-end iterator of this list.
+     */
+    Iterator end() {
+        return this->items.end();
+    }
+
+    /*
+     Returns a reverse iterator positioned at the last element of this list.
+     */
+    ReverseIterator rbegin() {
+        return this->items.rbegin();
+    }
+
+    /*
+     Returns the past-the-start reverse iterator of this list.
+     */
+    ReverseIterator rend() {
+        return this->items.rend();
+    }
+
+    /*
+     Returns a string representation of this list.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "List at " << this << std::endl;
+        if (!this->items.empty()) {
+            sout << "List contains " << this->items.size() << " elements" << std::endl;
+            sout << "Elements stored at " << this->items.data() << std::endl;
+        }
+        else {
+            sout << "This list is empty" << std::endl;
+        }
+        return sout.str();
+    }
+
+};
+
+/*
+ Alias for the contiguous list.
+ */
+template <typename T>
+using ArrayList = List<T, ContiguousStorage>;
@@ -0,0 +1,690 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "Pair.h"
+
+/*
+ An ordered map from keys of type K to values of type V, kept in a B+ tree.
+ Every node holds up to NodeCapacity keys in a contiguous array, so a
+ lookup touches O(log n / log NodeCapacity) nodes and scans each one in
+ cache-friendly order. Entries live in the leaves, which are linked in key
+ order, so in-order and range iteration walk arrays rather than pointers.
+
+ Keys are ordered by Compare, a strict weak ordering like std::less. The
+ map stores copies of its keys and values, so both must be default
+ constructible and copyable. Entries are presented as Pairs pointing at
+ the key and value stored in the map. Pointers to keys and values, and
+ iterators, stay valid until the next insertion or removal.
+ */
+template <typename K, typename V, typename Compare = std::less<K>, int NodeCapacity = 32>
+class BTreeMap {
+
+    static_assert(NodeCapacity >= 4, "nodes must hold at least four keys");
+
+protected:
+
+    /*
+     Nodes other than the root are kept at least this full.
+     */
+    static const int minimumCount = NodeCapacity / 2;
+
+    /*
+     The part common to leaves and internal nodes. Arrays have room for one
+     entry more than NodeCapacity, so a node can overflow by one before it
+     is split.
+     */
+    struct TreeNode {
+        bool isLeaf;
+        int count;
+
+        TreeNode(bool isLeaf) {
+            this->isLeaf = isLeaf;
+            this->count = 0;
+        }
+    };
+
+    /*
+     A leaf: count entries in key order, and links to the neighbouring
+     leaves.
+     */
+    struct Leaf : TreeNode {
+        K keys[NodeCapacity + 1];
+        V values[NodeCapacity + 1];
+        Leaf* nextLeaf;
+        Leaf* previousLeaf;
+
+        Leaf() : TreeNode(true) {
+            this->nextLeaf = nullptr;
+            this->previousLeaf = nullptr;
+        }
+    };
+
+    /*
+     An internal node: count separator keys and count + 1 children. Child k
+     holds the keys that are at least keys[k - 1] and less than keys[k].
+     */
+    struct Internal : TreeNode {
+        K keys[NodeCapacity + 1];
+        TreeNode* children[NodeCapacity + 2];
+
+        Internal() : TreeNode(false) {}
+    };
+
+    TreeNode* root;
+    Leaf* firstLeaf;
+    int numEntries;
+    Compare less;
+
+    /*
+     Returns the number of keys in the specified array that are less than
+     the specified key.
+     */
+    int lowerIndex(const K* keys, int count, const K& key) const {
+        int low = 0;
+        int high = count;
+        while (low < high) {
+            int middle = (low + high) / 2;
+            if (this->less(keys[middle], key)) {
+                low = middle + 1;
+            }
+            else {
+                high = middle;
+            }
+        }
+        return low;
+    }
+
+    /*
+     Returns the number of keys in the specified array that are less than
+     or equivalent to the specified key.
+     */
+    int upperIndex(const K* keys, int count, const K& key) const {
+        int low = 0;
+        int high = count;
+        while (low < high) {
+            int middle = (low + high) / 2;
+            if (this->less(key, keys[middle])) {
+                high = middle;
+            }
+            else {
+                low = middle + 1;
+            }
+        }
+        return low;
+    }
+
+    /*
+     Returns the leaf that would hold the specified key.
+     */
+    Leaf* findLeaf(const K& key) const {
+        TreeNode* node = this->root;
+        while (!node->isLeaf) {
+            Internal* internal = static_cast<Internal*>(node);
+            node = internal->children[this->upperIndex(internal->keys, internal->count, key)];
+        }
+        return static_cast<Leaf*>(node);
+    }
+
+    /*
+     Inserts or replaces the entry for the specified key in the subtree at
+     the specified node. If the node splits, the new right node and the
+     separator for it are returned through newRight and separator. Sets
+     result to the stored value and added to whether the key was new.
+     */
+    void insert(TreeNode* node, const K& key, V& value, TreeNode*& newRight, K& separator, V*& result, bool& added) {
+        newRight = nullptr;
+        if (node->isLeaf) {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            int position = this->lowerIndex(leaf->keys, leaf->count, key);
+            if (position < leaf->count && !this->less(key, leaf->keys[position])) {
+                leaf->values[position] = std::move(value);
+                result = &leaf->values[position];
+                added = false;
+                return;
+            }
+            for (int k = leaf->count; k > position; k--) {
+                leaf->keys[k] = std::move(leaf->keys[k - 1]);
+                leaf->values[k] = std::move(leaf->values[k - 1]);
+            }
+            leaf->keys[position] = key;
+            leaf->values[position] = std::move(value);
+            leaf->count++;
+            added = true;
+            if (leaf->count <= NodeCapacity) {
+                result = &leaf->values[position];
+                return;
+            }
+            // split the leaf in half, and link the new one in after it
+            Leaf* right = new Leaf();
+            int leftCount = leaf->count / 2;
+            for (int k = leftCount; k < leaf->count; k++) {
+                right->keys[k - leftCount] = std::move(leaf->keys[k]);
+                right->values[k - leftCount] = std::move(leaf->values[k]);
+            }
+            right->count = leaf->count - leftCount;
+            leaf->count = leftCount;
+            right->nextLeaf = leaf->nextLeaf;
+            right->previousLeaf = leaf;
+            if (leaf->nextLeaf != nullptr) {
+                leaf->nextLeaf->previousLeaf = right;
+            }
+            leaf->nextLeaf = right;
+            result = position < leftCount ? &leaf->values[position] : &right->values[position - leftCount];
+            separator = right->keys[0];
+            newRight = right;
+            return;
+        }
+        Internal* internal = static_cast<Internal*>(node);
+        int childIndex = this->upperIndex(internal->keys, internal->count, key);
+        TreeNode* childRight;
+        K childSeparator;
+        this->insert(internal->children[childIndex], key, value, childRight, childSeparator, result, added);
+        if (childRight == nullptr) {
+            return;
+        }
+        for (int k = internal->count; k > childIndex; k--) {
+            internal->keys[k] = std::move(internal->keys[k - 1]);
+            internal->children[k + 1] = internal->children[k];
+        }
+        internal->keys[childIndex] = std::move(childSeparator);
+        internal->children[childIndex + 1] = childRight;
+        internal->count++;
+        if (internal->count <= NodeCapacity) {
+            return;
+        }
+        // split around the middle key, which moves up
+        Internal* right = new Internal();
+        int middle = internal->count / 2;
+        separator = std::move(internal->keys[middle]);
+        for (int k = middle + 1; k < internal->count; k++) {
+            right->keys[k - middle - 1] = std::move(internal->keys[k]);
+        }
+        for (int k = middle + 1; k <= internal->count; k++) {
+            right->children[k - middle - 1] = internal->children[k];
+        }
+        right->count = internal->count - middle - 1;
+        internal->count = middle;
+        newRight = right;
+    }
+
+    /*
+     Refills child childIndex of the specified node, which has dropped below
+     the minimum, by borrowing from a sibling or merging with one.
+     */
+    void rebalance(Internal* parent, int childIndex) {
+        TreeNode* left = childIndex > 0 ? parent->children[childIndex - 1] : nullptr;
+        TreeNode* right = childIndex < parent->count ? parent->children[childIndex + 1] : nullptr;
+        if (left != nullptr && left->count > minimumCount) {
+            this->borrowFromLeft(parent, childIndex);
+        }
+        else if (right != nullptr && right->count > minimumCount) {
+            this->borrowFromRight(parent, childIndex);
+        }
+        else if (right != nullptr) {
+            this->merge(parent, childIndex);
+        }
+        else if (left != nullptr) {
+            this->merge(parent, childIndex - 1);
+        }
+    }
+
+    /*
+     Moves the last entry of child childIndex - 1 to the front of child
+     childIndex.
+     */
+    void borrowFromLeft(Internal* parent, int childIndex) {
+        TreeNode* child = parent->children[childIndex];
+        TreeNode* left = parent->children[childIndex - 1];
+        if (child->isLeaf) {
+            Leaf* leafChild = static_cast<Leaf*>(child);
+            Leaf* leafLeft = static_cast<Leaf*>(left);
+            for (int k = leafChild->count; k > 0; k--) {
+                leafChild->keys[k] = std::move(leafChild->keys[k - 1]);
+                leafChild->values[k] = std::move(leafChild->values[k - 1]);
+            }
+            leafChild->keys[0] = std::move(leafLeft->keys[leafLeft->count - 1]);
+            leafChild->values[0] = std::move(leafLeft->values[leafLeft->count - 1]);
+            parent->keys[childIndex - 1] = leafChild->keys[0];
+        }
+        else {
+            Internal* internalChild = static_cast<Internal*>(child);
+            Internal* internalLeft = static_cast<Internal*>(left);
+            for (int k = internalChild->count; k > 0; k--) {
+                internalChild->keys[k] = std::move(internalChild->keys[k - 1]);
+            }
+            for (int k = internalChild->count + 1; k > 0; k--) {
+                internalChild->children[k] = internalChild->children[k - 1];
+            }
+            internalChild->keys[0] = std::move(parent->keys[childIndex - 1]);
+            internalChild->children[0] = internalLeft->children[internalLeft->count];
+            parent->keys[childIndex - 1] = std::move(internalLeft->keys[internalLeft->count - 1]);
+        }
+        child->count++;
+        left->count--;
+    }
+
+    /*
+     Moves the first entry of child childIndex + 1 to the end of child
+     childIndex.
+     */
+    void borrowFromRight(Internal* parent, int childIndex) {
+        TreeNode* child = parent->children[childIndex];
+        TreeNode* right = parent->children[childIndex + 1];
+        if (child->isLeaf) {
+            Leaf* leafChild = static_cast<Leaf*>(child);
+            Leaf* leafRight = static_cast<Leaf*>(right);
+            leafChild->keys[leafChild->count] = std::move(leafRight->keys[0]);
+            leafChild->values[leafChild->count] = std::move(leafRight->values[0]);
+            for (int k = 1; k < leafRight->count; k++) {
+                leafRight->keys[k - 1] = std::move(leafRight->keys[k]);
+                leafRight->values[k - 1] = std::move(leafRight->values[k]);
+            }
+            parent->keys[childIndex] = leafRight->keys[0];
+        }
+        else {
+            Internal* internalChild = static_cast<Internal*>(child);
+            Internal* internalRight = static_cast<Internal*>(right);
+            internalChild->keys[internalChild->count] = std::move(parent->keys[childIndex]);
+            internalChild->children[internalChild->count + 1] = internalRight->children[0];
+            parent->keys[childIndex] = std::move(internalRight->keys[0]);
+            for (int k = 1; k < internalRight->count; k++) {
+                internalRight->keys[k - 1] = std::move(internalRight->keys[k]);
+            }
+            for (int k = 1; k <= internalRight->count; k++) {
+                internalRight->children[k - 1] = internalRight->children[k];
+            }
+        }
+        child->count++;
+        right->count--;
+    }
+
+    /*
+     Merges child leftIndex + 1 of the specified node into child leftIndex,
+     and removes the separator between them.
+     */
+    void merge(Internal* parent, int leftIndex) {
+        TreeNode* left = parent->children[leftIndex];
+        TreeNode* right = parent->children[leftIndex + 1];
+        if (left->isLeaf) {
+            Leaf* leafLeft = static_cast<Leaf*>(left);
+            Leaf* leafRight = static_cast<Leaf*>(right);
+            for (int k = 0; k < leafRight->count; k++) {
+                leafLeft->keys[leafLeft->count + k] = std::move(leafRight->keys[k]);
+                leafLeft->values[leafLeft->count + k] = std::move(leafRight->values[k]);
+            }
+            leafLeft->count += leafRight->count;
+            leafLeft->nextLeaf = leafRight->nextLeaf;
+            if (leafRight->nextLeaf != nullptr) {
+                leafRight->nextLeaf->previousLeaf = leafLeft;
+            }
+            delete leafRight;
+        }
+        else {
+            Internal* internalLeft = static_cast<Internal*>(left);
+            Internal* internalRight = static_cast<Internal*>(right);
+            internalLeft->keys[internalLeft->count] = std::move(parent->keys[leftIndex]);
+            for (int k = 0; k < internalRight->count; k++) {
+                internalLeft->keys[internalLeft->count + 1 + k] = std::move(internalRight->keys[k]);
+            }
+            for (int k = 0; k <= internalRight->count; k++) {
+                internalLeft->children[internalLeft->count + 1 + k] = internalRight->children[k];
+            }
+            internalLeft->count += internalRight->count + 1;
+            delete internalRight;
+        }
+        for (int k = leftIndex + 1; k < parent->count; k++) {
+            parent->keys[k - 1] = std::move(parent->keys[k]);
+            parent->children[k] = parent->children[k + 1];
+        }
+        parent->count--;
+    }
+
+    /*
+     Removes the entry for the specified key from the subtree at the
+     specified node. Returns true if and only if the key was found. The
+     caller rebalances the node if it ends up below the minimum.
+     */
+    bool erase(TreeNode* node, const K& key) {
+        if (node->isLeaf) {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            int position = this->lowerIndex(leaf->keys, leaf->count, key);
+            if (position == leaf->count || this->less(key, leaf->keys[position])) {
+                return false;
+            }
+            for (int k = position + 1; k < leaf->count; k++) {
+                leaf->keys[k - 1] = std::move(leaf->keys[k]);
+                leaf->values[k - 1] = std::move(leaf->values[k]);
+            }
+            leaf->count--;
+            // release whatever the vacated slot held
+            leaf->keys[leaf->count] = K();
+            leaf->values[leaf->count] = V();
+            return true;
+        }
+        Internal* internal = static_cast<Internal*>(node);
+        int childIndex = this->upperIndex(internal->keys, internal->count, key);
+        bool result = this->erase(internal->children[childIndex], key);
+        if (result && internal->children[childIndex]->count < minimumCount) {
+            this->rebalance(internal, childIndex);
+        }
+        return result;
+    }
+
+    /*
+     Deletes the subtree at the specified node.
+     */
+    void destroy(TreeNode* node) {
+        if (node->isLeaf) {
+            delete static_cast<Leaf*>(node);
+        }
+        else {
+            Internal* internal = static_cast<Internal*>(node);
+            for (int k = 0; k <= internal->count; k++) {
+                this->destroy(internal->children[k]);
+            }
+            delete internal;
+        }
+    }
+
+public:
+
+    /*
+     A forward iterator over the entries of a map, in key order.
+     Dereferencing it yields a Pair pointing at the key and the value.
+     */
+    class Iterator {
+
+    protected:
+
+        Leaf* leaf;
+        int position;
+
+    public:
+
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Pair<K, V> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Pair<K, V>* pointer;
+        typedef Pair<K, V> reference;
+
+        /*
+         Creates an iterator at the specified position of the specified
+         leaf, moving on to the next leaf if the position is past its end.
+         The past-the-end iterator has a null leaf.
+         */
+        Iterator(Leaf* leaf, int position) {
+            this->leaf = leaf;
+            this->position = position;
+            while (this->leaf != nullptr && this->position >= this->leaf->count) {
+                this->leaf = this->leaf->nextLeaf;
+                this->position = 0;
+            }
+        }
+
+        Pair<K, V> operator*() const {
+            return Pair<K, V>(&this->leaf->keys[this->position], &this->leaf->values[this->position]);
+        }
+
+        Iterator& operator++() {
+            this->position++;
+            if (this->position >= this->leaf->count) {
+                *this = Iterator(this->leaf->nextLeaf, 0);
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator result = *this;
+            ++(*this);
+            return result;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return this->leaf == other.leaf && (this->leaf == nullptr || this->position == other.position);
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
+        }
+
+    };
+
+    typedef Iterator iterator;
+
+    /*
+     A range of entries, usable in a range-based for loop.
+     */
+    class Range {
+
+    protected:
+
+        Iterator first;
+        Iterator last;
+
+    public:
+
+        Range(Iterator first, Iterator last) : first(first), last(last) {}
+
+        Iterator begin() {
+            return this->first;
+        }
+
+        Iterator end() {
+            return this->last;
+        }
+
+    };
+
+    /*
+     Creates an empty map using the specified ordering.
+     */
+    BTreeMap(Compare less = Compare()) : less(less) {
+        this->firstLeaf = new Leaf();
+        this->root = this->firstLeaf;
+        this->numEntries = 0;
+    }
+
+    /*
+     Creates a map holding copies of the entries of the specified one.
+     */
+    BTreeMap(const BTreeMap<K, V, Compare, NodeCapacity>& other) : BTreeMap(other.less) {
+        for (Leaf* leaf = other.firstLeaf; leaf != nullptr; leaf = leaf->nextLeaf) {
+            for (int k = 0; k < leaf->count; k++) {
+                this->put(leaf->keys[k], leaf->values[k]);
+            }
+        }
+    }
+
+    /*
+     Creates a map that takes over the entries of the specified one, leaving
+     it empty.
+     */
+    BTreeMap(BTreeMap<K, V, Compare, NodeCapacity>&& other) : BTreeMap(other.less) {
+        this->swap(other);
+    }
+
+    /*
+     Replaces the entries of this map with copies of, or the entries of, the
+     specified map.
+     */
+    BTreeMap<K, V, Compare, NodeCapacity>& operator=(BTreeMap<K, V, Compare, NodeCapacity> other) {
+        this->swap(other);
+        return *this;
+    }
+
+    ~BTreeMap() {
+        this->destroy(this->root);
+    }
+
+    /*
+     Exchanges the contents of this map and the specified one.
+     */
+    void swap(BTreeMap<K, V, Compare, NodeCapacity>& other) {
+        std::swap(this->root, other.root);
+        std::swap(this->firstLeaf, other.firstLeaf);
+        std::swap(this->numEntries, other.numEntries);
+        std::swap(this->less, other.less);
+    }
+
+    /*
+     Returns true if and only if this map has no entries.
+     */
+    bool isEmpty() {
+        return this->numEntries == 0;
+    }
+
+    /*
+     Returns the number of entries in this map.
+     */
+    int getSize() {
+        return this->numEntries;
+    }
+
+    /*
+     Returns the number of levels in the tree, counting the leaves.
+     */
+    int getHeight() {
+        int result = 1;
+        for (TreeNode* node = this->root; !node->isLeaf; node = static_cast<Internal*>(node)->children[0]) {
+            result++;
+        }
+        return result;
+    }
+
+    /*
+     Associates the specified value with the specified key, replacing any
+     value the key already had. Returns a pointer to the stored value.
+     */
+    V* put(const K& key, V value) {
+        TreeNode* newRight;
+        K separator;
+        V* result;
+        bool added;
+        this->insert(this->root, key, value, newRight, separator, result, added);
+        if (newRight != nullptr) {
+            Internal* newRoot = new Internal();
+            newRoot->keys[0] = std::move(separator);
+            newRoot->children[0] = this->root;
+            newRoot->children[1] = newRight;
+            newRoot->count = 1;
+            this->root = newRoot;
+        }
+        if (added) {
+            this->numEntries++;
+        }
+        return result;
+    }
+
+    /*
+     Returns a pointer to the value associated with the specified key, or
+     the null pointer if the key is not in this map.
+     */
+    V* get(const K& key) {
+        Leaf* leaf = this->findLeaf(key);
+        int position = this->lowerIndex(leaf->keys, leaf->count, key);
+        V* result = nullptr;
+        if (position < leaf->count && !this->less(key, leaf->keys[position])) {
+            result = &leaf->values[position];
+        }
+        return result;
+    }
+
+    /*
+     Returns true if and only if the specified key is in this map.
+     */
+    bool containsKey(const K& key) {
+        return this->get(key) != nullptr;
+    }
+
+    /*
+     Removes the entry for the specified key. Returns true if and only if
+     the key was in this map.
+     */
+    bool remove(const K& key) {
+        bool result = this->erase(this->root, key);
+        if (result) {
+            this->numEntries--;
+            // an internal root left with a single child is replaced by it
+            if (!this->root->isLeaf && this->root->count == 0) {
+                Internal* oldRoot = static_cast<Internal*>(this->root);
+                this->root = oldRoot->children[0];
+                delete oldRoot;
+            }
+        }
+        return result;
+    }
+
+    /*
+     Removes every entry from this map.
+     */
+    void clear() {
+        this->destroy(this->root);
+        this->firstLeaf = new Leaf();
+        this->root = this->firstLeaf;
+        this->numEntries = 0;
+    }
+
+    /*
+     Returns an iterator positioned at the first entry whose key is not less
+     than the specified key, or the past-the-end iterator if there is none.
+     */
+    Iterator lowerBound(const K& key) {
+        Leaf* leaf = this->findLeaf(key);
+        return Iterator(leaf, this->lowerIndex(leaf->keys, leaf->count, key));
+    }
+
+    /*
+     Returns an iterator positioned at the first entry whose key is greater
+     than the specified key, or the past-the-end iterator if there is none.
+     */
+    Iterator upperBound(const K& key) {
+        Leaf* leaf = this->findLeaf(key);
+        return Iterator(leaf, this->upperIndex(leaf->keys, leaf->count, key));
+    }
+
+    /*
+     Returns the entries whose keys are at least low and less than high, in
+     key order.
+     */
+    Range getRange(const K& low, const K& high) {
+        Iterator first = this->lowerBound(low);
+        Iterator last = this->less(low, high) ? this->lowerBound(high) : first;
+        return Range(first, last);
+    }
+
+    /*
+     Returns an iterator positioned at the entry with the smallest key.
+     */
+    Iterator begin() {
+        return Iterator(this->firstLeaf, 0);
+    }
+
+    /*
+     Returns the past-the-end iterator of this map.
+     */
+    Iterator end() {
+        return Iterator(nullptr, 0);
+    }
+
+    /*
+     Returns a string representation of this map.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "BTreeMap at " << this << std::endl;
+        if (this->numEntries > 0) {
+            sout << "Map contains " << this->numEntries << " entries in a tree of height " << this->getHeight() << std::endl;
+        }
+        else {
+            sout << "This map is empty" << std::endl;
+        }
+        return sout.str();
+    }
+
+};
@@ -1,19 +1,27 @@
 
 #pragma once
 
+#include <cstddef>
 #include <iostream>
+#include <iterator>
 #include <string>
 #include <sstream>
 
+#include "ListStats.h"
 #include "Node.h"
+#include "NodeAllocator.h"
 
 
 /*
  A template representing doubly-linked chains. A chain supports insertion and
  removal at either end, and peek at any valid position.
+
+ Nodes are obtained from the Allocator policy, which by default takes them
+ from a per-type slab pool (see NodeAllocator.h). With TEXTUALRPG_LIST_STATS
+ defined, a chain also counts its allocations and walks (see ListStats.h).
  */
-template <typename T>
-class Chain {
+template <typename T, typename Allocator = PooledNodeAllocator>
+class Chain : public ListStatsRecorder<T> {
 
     // for testing only
     friend class ChainTester;
@@ -35,8 +43,207 @@ protected:
      */
     int numNodes;
 
+    /*
+     Cursor caching the most recently visited node and its position, so
+     that positional access close to the previous access does not have to
+     walk the chain from the start. The cursor is invalid when cursorNode is
+     the null pointer.
+     */
+    Node<T>* cursorNode;
+    int cursorPosition;
+
+    /*
+     Creates a node containing the specified data, using the allocator.
+     */
+    Node<T>* createNode(T* data) {
+        this->recordAllocation();
+        return Allocator::template create<Node<T>>(data);
+    }
+
+    /*
+     Releases a node created by createNode.
+     */
+    void destroyNode(Node<T>* node) {
+        this->recordFree();
+        Allocator::destroy(node);
+    }
+
+    /*
+     Appends new nodes holding the data of the specified chain to this one.
+     */
+    void copyNodesFrom(const Chain<T, Allocator>& other) {
+        Allocator::template reserve<Node<T>>(other.numNodes);
+        for (Node<T>* node = other.startNode; node != nullptr; node = node->getNextNode()) {
+            this->insertAtEnd(node->getData());
+        }
+    }
+
+    /*
+     Moves the nodes of the specified chain into this one, which must be
+     empty, leaving the specified chain empty.
+     */
+    void takeNodesFrom(Chain<T, Allocator>& other) {
+        this->startNode = other.startNode;
+        this->endNode = other.endNode;
+        this->numNodes = other.numNodes;
+        this->cursorNode = other.cursorNode;
+        this->cursorPosition = other.cursorPosition;
+        other.startNode = nullptr;
+        other.endNode = nullptr;
+        other.numNodes = 0;
+        other.invalidateCursor();
+    }
+
+    /*
+     Invalidates the cursor. Must be called whenever nodes are unlinked from
+     this chain, or positions shift in a way the cursor can't follow.
+     */
+    void invalidateCursor() {
+        this->cursorNode = nullptr;
+        this->cursorPosition = -1;
+    }
+
+    /*
+     Returns the node at the specified position of this chain, or the null
+     pointer if the position is not valid. The walk starts from whichever of
+     the start node, the end node, or the cursor is closest to the position,
+     and leaves the cursor at the returned node. The number of nodes walked
+     past is added to the specified statistics counter, if any.
+     */
+    Node<T>* getNodeAt(int position, long ListStatistics::* hopCounter = nullptr) {
+        if (position < 0 || position >= this->numNodes) {
+            return nullptr;
+        }
+        // distances from the start, the end, and the cursor
+        int fromStart = position;
+        int fromEnd = this->numNodes - 1 - position;
+        int fromCursor = this->numNodes;
+        if (this->cursorNode != nullptr) {
+            fromCursor = position - this->cursorPosition;
+            if (fromCursor < 0) {
+                fromCursor = -fromCursor;
+            }
+        }
+        Node<T>* currentNode;
+        int currentPosition;
+        if (fromCursor <= fromStart && fromCursor <= fromEnd) {
+            currentNode = this->cursorNode;
+            currentPosition = this->cursorPosition;
+        }
+        else if (fromStart <= fromEnd) {
+            currentNode = this->startNode;
+            currentPosition = 0;
+        }
+        else {
+            currentNode = this->endNode;
+            currentPosition = this->numNodes - 1;
+        }
+        this->recordHops(hopCounter, position > currentPosition ? position - currentPosition : currentPosition - position);
+        while (currentPosition < position) {
+            currentNode = currentNode->getNextNode();
+            currentPosition++;
+        }
+        while (currentPosition > position) {
+            currentNode = currentNode->getPreviousNode();
+            currentPosition--;
+        }
+        this->cursorNode = currentNode;
+        this->cursorPosition = position;
+        return currentNode;
+    }
+
 public:
 
+    /*
+     A bidirectional iterator over the nodes of a chain. Dereferencing the
+     iterator yields the data pointer stored in the current node, so a chain
+     can be traversed with a range-based for loop, or handed to standard
+     algorithms, in a single pass.
+     */
+    class Iterator {
+
+    protected:
+
+        /*
+         The chain being traversed, and the node the iterator is at. The
+         past-the-end iterator has a null current node.
+         */
+        Chain<T, Allocator>* chain;
+        Node<T>* currentNode;
+
+    public:
+
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef T** pointer;
+        typedef T* reference;
+
+        Iterator() {
+            this->chain = nullptr;
+            this->currentNode = nullptr;
+        }
+
+        Iterator(Chain<T, Allocator>* chain, Node<T>* currentNode) {
+            this->chain = chain;
+            this->currentNode = currentNode;
+        }
+
+        /*
+         Returns the node the iterator is at.
+         */
+        Node<T>* getNode() const {
+            return this->currentNode;
+        }
+
+        T* operator*() const {
+            return this->currentNode->getData();
+        }
+
+        Iterator& operator++() {
+            this->currentNode = this->currentNode->getNextNode();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator result = *this;
+            ++(*this);
+            return result;
+        }
+
+        /*
+         Decrementing the past-the-end iterator moves it to the end node.
+         */
+        Iterator& operator--() {
+            if (this->currentNode == nullptr) {
+                this->currentNode = this->chain->endNode;
+            }
+            else {
+                this->currentNode = this->currentNode->getPreviousNode();
+            }
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator result = *this;
+            --(*this);
+            return result;
+        }
+
+        bool operator==(const Iterator& rhs) const {
+            return this->currentNode == rhs.currentNode;
+        }
+
+        bool operator!=(const Iterator& rhs) const {
+            return this->currentNode != rhs.currentNode;
+        }
+
+    };
+
+    typedef Iterator iterator;
+    typedef std::reverse_iterator<Iterator> ReverseIterator;
+    typedef ReverseIterator reverse_iterator;
+
     /*
      Creates an empty chain.
      */
@@ -44,6 +251,82 @@ public:
         this->startNode = nullptr;
         this->endNode = nullptr;
         this->numNodes = 0;
+        this->invalidateCursor();
+    }
+
+    /*
+     Creates a chain holding the same data pointers as the specified one, in
+     new nodes. The data itself is not copied: chains never own their data.
+     */
+    Chain(const Chain<T, Allocator>& other) : Chain() {
+        this->copyNodesFrom(other);
+    }
+
+    /*
+     Creates a chain that takes over the nodes of the specified one, leaving
+     it empty.
+     */
+    Chain(Chain<T, Allocator>&& other) : Chain() {
+        this->takeNodesFrom(other);
+    }
+
+    /*
+     Replaces the nodes of this chain with copies of those of the specified
+     chain.
+     */
+    Chain<T, Allocator>& operator=(const Chain<T, Allocator>& other) {
+        if (this != &other) {
+            this->clear();
+            this->copyNodesFrom(other);
+        }
+        return *this;
+    }
+
+    /*
+     Replaces the nodes of this chain with those of the specified chain,
+     leaving it empty.
+     */
+    Chain<T, Allocator>& operator=(Chain<T, Allocator>&& other) {
+        if (this != &other) {
+            this->clear();
+            this->takeNodesFrom(other);
+        }
+        return *this;
+    }
+
+    /*
+     Releases every node of this chain. The data is left alone.
+     */
+    virtual ~Chain() {
+        this->clear();
+    }
+
+    /*
+     Removes every node from this chain. The data is left alone.
+     */
+    void clear() {
+        Node<T>* currentNode = this->startNode;
+        while (currentNode != nullptr) {
+            Node<T>* nextNode = currentNode->getNextNode();
+            this->destroyNode(currentNode);
+            currentNode = nextNode;
+        }
+        this->startNode = nullptr;
+        this->endNode = nullptr;
+        this->numNodes = 0;
+        this->invalidateCursor();
+    }
+
+    /*
+     Returns the statistics of this chain: its nodes now, and what it has
+     recorded since it was created. Only numNodes and bytesInUse are
+     nonzero unless TEXTUALRPG_LIST_STATS is defined.
+     */
+    ListStatistics getStatistics() {
+        ListStatistics result = this->getRecorded();
+        result.numNodes = this->numNodes;
+        result.bytesInUse = this->numNodes * static_cast<long>(sizeof(Node<T>));
+        return result;
     }
 
     /*
@@ -63,17 +346,15 @@ public:
     /*
      Returns a pointer to the dat stored in the node at the
      specified position of this chain. Does not remove the node from this chain.
+     If the position does not exist in this chain, returns the null pointer.
      */
     T* peek(int position) {
         T* result;
-        if (this->isEmpty()) {
+        Node<T>* currentNode = this->getNodeAt(position, &ListStatistics::peekHops);
+        if (currentNode == nullptr) {
             result = nullptr;
         }
         else {
-            Node<T>* currentNode = this->startNode;
-            for (int k = 0; k < position; k++) {
-                currentNode = currentNode->getNextNode();
-            }
             result = currentNode->getData();
         }
         return result;
@@ -84,11 +365,8 @@ public:
      does not exist in this chain, this method does nothing.
      */
     void setData(T* data, int position) {
-        if (!this->isEmpty()) {
-            Node<T>* currentNode = this->startNode;
-            for (int k = 0; k < position; k++) {
-                currentNode = currentNode->getNextNode();
-            }
+        Node<T>* currentNode = this->getNodeAt(position, &ListStatistics::setDataHops);
+        if (currentNode != nullptr) {
             currentNode->setData(data);
         }
     }
@@ -97,7 +375,7 @@ public:
      Inserts the specified data at the beginning of this chain.
      */
     void insertAtStart(T* data) {
-        Node<T>* newStart = new Node<T>(data);
+        Node<T>* newStart = this->createNode(data);
         if (this->isEmpty()) {
             this->startNode = newStart;
             this->endNode = newStart;
@@ -108,6 +386,8 @@ public:
             this->startNode->setPreviousNode(newStart);
             this->startNode = newStart;
             this->numNodes++;
+            // every existing node moved up one position
+            this->cursorPosition++;
         }
     }
 
@@ -121,16 +401,24 @@ public:
         }
         else if (this->numNodes == 1) {
             result = this->startNode->getData();
-            delete startNode;
+            this->destroyNode(this->startNode);
             this->startNode = nullptr;
             this->endNode = nullptr;
             this->numNodes = 0;
+            this->invalidateCursor();
         }
         else {
             result = this->startNode->getData();
             Node<T>* newStart = this->startNode->getNextNode();
             newStart->setPreviousNode(nullptr);
-            delete this->startNode;
+            if (this->cursorNode == this->startNode) {
+                this->invalidateCursor();
+            }
+            else {
+                // every remaining node moved down one position
+                this->cursorPosition--;
+            }
+            this->destroyNode(this->startNode);
             this->startNode = newStart;
             this->numNodes--;
         }
@@ -147,16 +435,20 @@ public:
         }
         else if (this->numNodes == 1) {
             result = this->endNode->getData();
-            delete startNode;
+            this->destroyNode(this->startNode);
             this->startNode = nullptr;
             this->endNode = nullptr;
             this->numNodes = 0;
+            this->invalidateCursor();
         }
         else {
             result = this->endNode->getData();
             Node<T>* newEnd = this->endNode->getPreviousNode();
             newEnd->setNextNode(nullptr);
-            delete this->endNode;
+            if (this->cursorNode == this->endNode) {
+                this->invalidateCursor();
+            }
+            this->destroyNode(this->endNode);
             this->endNode = newEnd;
             this->numNodes--;
         }
@@ -164,7 +456,7 @@ public:
     }
 
     void insertAtEnd(T* data) {
-        Node<T>* newEnd = new Node<T>(data);
+        Node<T>* newEnd = this->createNode(data);
         if (this->isEmpty()) {
             this->endNode = newEnd;
             this->startNode = newEnd;
@@ -178,6 +470,34 @@ public:
         }
     }
 
+    /*
+     Returns an iterator positioned at the start node of this chain.
+     */
+    Iterator begin() {
+        return Iterator(this, this->startNode);
+    }
+
+    /*
+     Returns the past-the-end iterator of this chain.
+     */
+    Iterator end() {
+        return Iterator(this, nullptr);
+    }
+
+    /*
+     Returns a reverse iterator positioned at the end node of this chain.
+     */
+    ReverseIterator rbegin() {
+        return ReverseIterator(this->end());
+    }
+
+    /*
+     Returns the past-the-start reverse iterator of this chain.
+     */
+    ReverseIterator rend() {
+        return ReverseIterator(this->begin());
+    }
+
     /*
      Returns a string representation of this chain.
      */
@@ -0,0 +1 @@
+#include "ChainTester.h"
@@ -0,0 +1,1906 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "ArrayList.h"
+#include "Chain.h"
+#include "Deque.h"
+#include "List.h"
+#include "ListStats.h"
+#include "MPSCQueue.h"
+#include "NodeAllocator.h"
+#include "PersistentList.h"
+#include "Queue.h"
+#include "SmallList.h"
+#include "SortedList.h"
+#include "Stack.h"
+#include "TestResults.h"
+#include "UnrolledList.h"
+#include "ValueList.h"
+
+class ChainTester {
+
+protected:
+
+    /*
+     Applies a pseudo-random sequence of insertions, removals, splits,
+     appends and setData calls to the specified list, mirroring each on a
+     vector. After every step, checks peek and getIndex against the vector.
+     Returns the number of disagreements.
+     */
+    template <typename ListType>
+    static int countModelMismatches(ListType* list, unsigned int seed, int numSteps) {
+        int* values = new int[16];
+        for (int k = 0; k < 16; k++) {
+            values[k] = k;
+        }
+        std::vector<int*> expected;
+        int mismatches = 0;
+        for (int step = 0; step < numSteps; step++) {
+            seed = seed * 1103515245 + 12345;
+            int choice = (seed >> 16) % 9;
+            int size = static_cast<int>(expected.size());
+            int position = size > 0 ? static_cast<int>((seed >> 8) % size) : 0;
+            int* item = &values[(seed >> 4) % 16];
+            if (choice == 0 && size < 40) {
+                list->insertAtStart(item);
+                expected.insert(expected.begin(), item);
+            }
+            else if (choice == 1 && size < 40) {
+                list->insertAtEnd(item);
+                expected.push_back(item);
+            }
+            else if (choice == 2 && size < 40) {
+                list->insertAtPosition(position, item);
+                expected.insert(expected.begin() + position, item);
+            }
+            else if (choice == 3 && size > 0) {
+                list->removeFromStart();
+                expected.erase(expected.begin());
+            }
+            else if (choice == 4 && size > 0) {
+                list->removeFromEnd();
+                expected.pop_back();
+            }
+            else if (choice == 5 && size > 0) {
+                if (list->removeFromPosition(position) != expected[position]) {
+                    mismatches++;
+                }
+                expected.erase(expected.begin() + position);
+            }
+            else if (choice == 6 && size > 1) {
+                // split and put the halves back together in the other order
+                ListType* lastHalf = list->splitAfter(position);
+                list->prepend(lastHalf);
+                std::vector<int*> rotated(expected.begin() + position + 1, expected.end());
+                rotated.insert(rotated.end(), expected.begin(), expected.begin() + position + 1);
+                expected = rotated;
+            }
+            else if (choice == 7 && size > 0) {
+                list->setData(item, position);
+                expected[position] = item;
+            }
+            size = static_cast<int>(expected.size());
+            if (list->getSize() != size) {
+                mismatches++;
+            }
+            for (int k = 0; k < size; k++) {
+                if (list->peek(k) != expected[k]) {
+                    mismatches++;
+                }
+            }
+            int* probe = &values[(seed >> 2) % 16];
+            std::vector<int*>::iterator it = std::find(expected.begin(), expected.end(), probe);
+            int expectedIndex = it == expected.end() ? -1 : static_cast<int>(it - expected.begin());
+            int actualIndex = list->getIndex(probe);
+            if ((expectedIndex < 0 && actualIndex >= 0) || (expectedIndex >= 0 && actualIndex != expectedIndex)) {
+                mismatches++;
+            }
+        }
+        return mismatches;
+    }
+
+    /*
+     Builds a list from an initializer list, inserts ranges at the start, in
+     the middle and past the end, and checks the result and getIndex.
+     Returns true if and only if every check passes.
+     */
+    template <typename ListType>
+    static bool rangeInsertMatches(int* values) {
+        ListType* list = new ListType({ &values[2], &values[3], &values[6] });
+        list->enableIndex();
+        std::vector<int*> front = { &values[0], &values[1] };
+        std::vector<int*> middle = { &values[4], &values[5] };
+        std::vector<int*> back = { &values[7], &values[8], &values[9] };
+        list->getIndex(&values[2]);
+        list->insertRange(list->getSize() + 5, back.begin(), back.end());
+        list->insertRange(-1, front.begin(), front.end());
+        list->insertRange(4, middle.begin(), middle.end());
+        bool correct = list->getSize() == 10;
+        for (int k = 0; k < 10 && correct; k++) {
+            correct = list->peek(k) == &values[k] && list->getIndex(&values[k]) == k;
+        }
+        ListType* copy = new ListType(list->begin(), list->end());
+        correct = correct && copy->getSize() == 10 && copy->peek(9) == &values[9];
+        return correct;
+    }
+
+    /*
+     Element type for the ValueList tests: counts live instances, and
+     records whether it was moved from.
+     */
+    struct Tracked {
+        static int& numLive() {
+            static int count = 0;
+            return count;
+        }
+        int value;
+        bool movedFrom;
+        Tracked(int value) : value(value), movedFrom(false) { numLive()++; }
+        Tracked(const Tracked& other) : value(other.value), movedFrom(false) { numLive()++; }
+        Tracked(Tracked&& other) : value(other.value), movedFrom(false) {
+            other.movedFrom = true;
+            numLive()++;
+        }
+        Tracked& operator=(const Tracked& other) = default;
+        Tracked& operator=(Tracked&& other) = default;
+        ~Tracked() { numLive()--; }
+        bool operator==(const Tracked& other) const { return this->value == other.value; }
+    };
+
+public:
+
+    /*
+     Create a list, insert at both ends, and test getSize, peek, and
+     removal from both ends.
+     */
+    static TestResults* test0() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        // build the list 0, 1, ..., 9 by inserting at both ends
+        int* values = new int[10];
+        for (int k = 0; k < 10; k++) {
+            values[k] = k;
+        }
+        List<int>* list = new List<int>();
+        for (int k = 5; k < 10; k++) {
+            list->insertAtEnd(&values[k]);
+        }
+        for (int k = 4; k >= 0; k--) {
+            list->insertAtStart(&values[k]);
+        }
+        // test getSize
+        pointsPossible++;
+        if (list->getSize() == 10) {
+            pointsEarned++;
+        }
+        else {
+            sout << "getSize returned " << list->getSize() << ", should have been 10" << std::endl;
+        }
+        // test peek
+        for (int k = 0; k < 10; k++) {
+            pointsPossible++;
+            if (list->peek(k) == &values[k]) {
+                pointsEarned++;
+            }
+            else {
+                sout << "peek(" << k << ") returned an incorrect value" << std::endl;
+            }
+        }
+        // test removal from both ends
+        pointsPossible++;
+        if (list->removeFromStart() == &values[0] && list->removeFromEnd() == &values[9]) {
+            pointsEarned++;
+        }
+        else {
+            sout << "removeFromStart or removeFromEnd returned an incorrect value" << std::endl;
+        }
+        pointsPossible++;
+        if (list->getSize() == 8 && list->peek(0) == &values[1]) {
+            pointsEarned++;
+        }
+        else {
+            sout << "list was not updated correctly by removeFromStart and removeFromEnd" << std::endl;
+        }
+        std::cout << "ChainTester::test0 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Test forward and reverse iteration, iteration over an empty list, and
+     use of the iterators with standard algorithms.
+     */
+    static TestResults* test1() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        // iterating over an empty list visits nothing
+        List<int>* list = new List<int>();
+        pointsPossible++;
+        if (list->begin() == list->end() && list->rbegin() == list->rend()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "begin and end differ on an empty list" << std::endl;
+        }
+        int* values = new int[10];
+        for (int k = 0; k < 10; k++) {
+            values[k] = k;
+            list->insertAtEnd(&values[k]);
+        }
+        // forward iteration visits the nodes in order
+        pointsPossible++;
+        int k = 0;
+        bool inOrder = true;
+        for (int* item : *list) {
+            inOrder = inOrder && item == &values[k];
+            k++;
+        }
+        if (inOrder && k == 10) {
+            pointsEarned++;
+        }
+        else {
+            sout << "forward iteration visited the nodes incorrectly" << std::endl;
+        }
+        // reverse iteration visits the nodes in reverse order
+        pointsPossible++;
+        k = 9;
+        inOrder = true;
+        for (List<int>::ReverseIterator it = list->rbegin(); it != list->rend(); ++it) {
+            inOrder = inOrder && *it == &values[k];
+            k--;
+        }
+        if (inOrder && k == -1) {
+            pointsEarned++;
+        }
+        else {
+            sout << "reverse iteration visited the nodes incorrectly" << std::endl;
+        }
+        // decrementing end() gives the end node
+        pointsPossible++;
+        List<int>::Iterator last = list->end();
+        --last;
+        if (*last == &values[9]) {
+            pointsEarned++;
+        }
+        else {
+            sout << "decrementing end() did not give the end node" << std::endl;
+        }
+        // standard algorithms
+        pointsPossible++;
+        List<int>::Iterator found = std::find(list->begin(), list->end(), &values[6]);
+        if (found != list->end() && std::distance(list->begin(), found) == 6) {
+            pointsEarned++;
+        }
+        else {
+            sout << "std::find did not locate the correct node" << std::endl;
+        }
+        pointsPossible++;
+        if (list->getIndex(&values[7]) == 7 && list->getIndex(new int(7)) < 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "getIndex returned an incorrect value" << std::endl;
+        }
+        std::cout << "ChainTester::test1 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Interleave positional peeks and setData with every kind of list
+     mutation, checking each peek against a vector holding the same data, so
+     that a stale cursor would be caught.
+     */
+    static TestResults* test2() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        int* values = new int[64];
+        for (int k = 0; k < 64; k++) {
+            values[k] = k;
+        }
+        List<int>* list = new List<int>();
+        std::vector<int*> expected;
+        unsigned int seed = 12345;
+        int mismatches = 0;
+        for (int step = 0; step < 2000; step++) {
+            seed = seed * 1103515245 + 12345;
+            int choice = (seed >> 16) % 10;
+            int size = static_cast<int>(expected.size());
+            int position = size > 0 ? static_cast<int>((seed >> 8) % size) : 0;
+            int* item = &values[step % 64];
+            if (choice == 0 && size < 40) {
+                list->insertAtStart(item);
+                expected.insert(expected.begin(), item);
+            }
+            else if (choice == 1 && size < 40) {
+                list->insertAtEnd(item);
+                expected.push_back(item);
+            }
+            else if (choice == 2 && size < 40) {
+                list->insertAtPosition(position, item);
+                expected.insert(expected.begin() + position, item);
+            }
+            else if (choice == 3 && size > 0) {
+                list->removeFromStart();
+                expected.erase(expected.begin());
+            }
+            else if (choice == 4 && size > 0) {
+                list->removeFromEnd();
+                expected.pop_back();
+            }
+            else if (choice == 5 && size > 0) {
+                list->removeFromPosition(position);
+                expected.erase(expected.begin() + position);
+            }
+            else if (choice == 6 && size > 1) {
+                // split and put the halves back together in the other order
+                List<int>* lastHalf = list->splitAfter(position);
+                list->prepend(lastHalf);
+                std::vector<int*> rotated(expected.begin() + position + 1, expected.end());
+                rotated.insert(rotated.end(), expected.begin(), expected.begin() + position + 1);
+                expected = rotated;
+            }
+            else if (choice == 7 && size > 0) {
+                list->setData(item, position);
+                expected[position] = item;
+            }
+            // peek near the last position, then somewhere else
+            size = static_cast<int>(expected.size());
+            if (size > 0) {
+                int near = position < size ? position : size - 1;
+                int far = static_cast<int>((seed >> 4) % size);
+                if (list->peek(near) != expected[near] || list->peek(far) != expected[far]) {
+                    mismatches++;
+                }
+                if (near + 1 < size && list->peek(near + 1) != expected[near + 1]) {
+                    mismatches++;
+                }
+            }
+        }
+        pointsPossible++;
+        if (mismatches == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "peek disagreed with the expected data " << mismatches << " times" << std::endl;
+        }
+        // out of range positions
+        pointsPossible++;
+        int size = list->getSize();
+        if (list->peek(-1) == nullptr && list->peek(size) == nullptr && list->removeFromPosition(size) == nullptr && list->getSize() == size) {
+            pointsEarned++;
+        }
+        else {
+            sout << "out of range positions were not handled correctly" << std::endl;
+        }
+        std::cout << "ChainTester::test2 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Test getIndex on an indexed list, interleaving lookups with every kind
+     of list mutation, and with data pointers that occur more than once.
+     */
+    static TestResults* test3() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        int* values = new int[16];
+        for (int k = 0; k < 16; k++) {
+            values[k] = k;
+        }
+        List<int>* list = new List<int>();
+        list->enableIndex();
+        std::vector<int*> expected;
+        unsigned int seed = 6789;
+        int mismatches = 0;
+        for (int step = 0; step < 3000; step++) {
+            seed = seed * 1103515245 + 12345;
+            int choice = (seed >> 16) % 8;
+            int size = static_cast<int>(expected.size());
+            int position = size > 0 ? static_cast<int>((seed >> 8) % size) : 0;
+            int* item = &values[(seed >> 4) % 16];
+            if (choice == 0 && size < 30) {
+                list->insertAtStart(item);
+                expected.insert(expected.begin(), item);
+            }
+            else if ((choice == 1 || choice == 2) && size < 30) {
+                list->insertAtEnd(item);
+                expected.push_back(item);
+            }
+            else if (choice == 3 && size > 0) {
+                list->removeFromStart();
+                expected.erase(expected.begin());
+            }
+            else if (choice == 4 && size > 0) {
+                list->removeFromEnd();
+                expected.pop_back();
+            }
+            else if (choice == 5 && size > 0) {
+                list->removeFromPosition(position);
+                expected.erase(expected.begin() + position);
+            }
+            else if (choice == 6 && size < 30) {
+                list->insertAtPosition(position, item);
+                expected.insert(expected.begin() + position, item);
+            }
+            else if (choice == 7 && size > 0) {
+                list->setData(item, position);
+                expected[position] = item;
+            }
+            // look up a few values
+            for (int j = 0; j < 3; j++) {
+                int* probe = &values[(seed >> (j + 2)) % 16];
+                std::vector<int*>::iterator it = std::find(expected.begin(), expected.end(), probe);
+                int expectedIndex = it == expected.end() ? -1 : static_cast<int>(it - expected.begin());
+                int actualIndex = list->getIndex(probe);
+                if ((expectedIndex < 0 && actualIndex >= 0) || (expectedIndex >= 0 && actualIndex != expectedIndex)) {
+                    mismatches++;
+                }
+            }
+        }
+        pointsPossible++;
+        if (mismatches == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "getIndex disagreed with the expected index " << mismatches << " times" << std::endl;
+        }
+        // a list below its index threshold still answers correctly
+        pointsPossible++;
+        List<int>* small = new List<int>();
+        small->enableIndex(100);
+        small->insertAtEnd(&values[3]);
+        small->insertAtEnd(&values[4]);
+        if (small->getIndex(&values[4]) == 1 && small->getIndex(&values[5]) < 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "getIndex returned an incorrect value below the index threshold" << std::endl;
+        }
+        // lookups between changes in the middle scan a stale index, and
+        // repeated lookups with no change in between rebuild it
+        pointsPossible++;
+        List<int>* edited = new List<int>();
+        edited->enableIndex();
+        for (int k = 0; k < 8; k++) {
+            edited->insertAtEnd(&values[k]);
+        }
+        bool correct = edited->getIndex(&values[7]) == 7;
+        for (int k = 8; k < 16; k++) {
+            edited->insertAtPosition(1, &values[k]);
+            correct = correct && edited->getIndex(&values[k]) == 1 && edited->getIndex(&values[0]) == 0;
+        }
+        for (int j = 0; j < 4; j++) {
+            for (int k = 8; k < 16; k++) {
+                correct = correct && edited->getIndex(&values[k]) == 16 - k;
+            }
+        }
+        edited->removeFromPosition(1);
+        if (correct && edited->getIndex(&values[15]) < 0 && edited->getIndex(&values[1]) == 8) {
+            pointsEarned++;
+        }
+        else {
+            sout << "getIndex returned an incorrect value around changes in the middle" << std::endl;
+        }
+        delete edited;
+        std::cout << "ChainTester::test3 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Compare the system allocations made by the pooled and heap node
+     allocators on the same workload, and check that the pool recycles
+     freed nodes.
+     */
+    static TestResults* test4() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        int value = 0;
+        // heap allocator: one system allocation per node
+        List<int, HeapNodeAllocator>* heapList = new List<int, HeapNodeAllocator>();
+        long before = SystemAllocationCounter::getCount();
+        for (int k = 0; k < 1000; k++) {
+            heapList->insertAtEnd(&value);
+        }
+        long heapAllocations = SystemAllocationCounter::getCount() - before;
+        pointsPossible++;
+        if (heapAllocations == 1000) {
+            pointsEarned++;
+        }
+        else {
+            sout << "heap allocator made " << heapAllocations << " system allocations, should have been 1000" << std::endl;
+        }
+        // pooled allocator: a handful of blocks
+        List<int, PooledNodeAllocator>* pooledList = new List<int, PooledNodeAllocator>();
+        long inUseBefore = NodePool<Node<int>>::getInstance().getNumInUse();
+        before = SystemAllocationCounter::getCount();
+        for (int k = 0; k < 1000; k++) {
+            pooledList->insertAtEnd(&value);
+        }
+        long pooledAllocations = SystemAllocationCounter::getCount() - before;
+        pointsPossible++;
+        if (pooledAllocations <= 1000 / 64) {
+            pointsEarned++;
+        }
+        else {
+            sout << "pooled allocator made " << pooledAllocations << " system allocations for 1000 nodes" << std::endl;
+        }
+        pointsPossible++;
+        if (NodePool<Node<int>>::getInstance().getNumInUse() - inUseBefore == 1000) {
+            pointsEarned++;
+        }
+        else {
+            sout << "pool reports the wrong number of nodes in use" << std::endl;
+        }
+        // freed nodes are recycled
+        for (int k = 0; k < 500; k++) {
+            pooledList->removeFromStart();
+        }
+        before = SystemAllocationCounter::getCount();
+        for (int k = 0; k < 500; k++) {
+            pooledList->insertAtStart(&value);
+        }
+        pointsPossible++;
+        if (SystemAllocationCounter::getCount() == before && pooledList->getSize() == 1000) {
+            pointsEarned++;
+        }
+        else {
+            sout << "pool did not recycle freed nodes" << std::endl;
+        }
+        std::cout << "ChainTester::test4 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Test the contiguous list against the same operations as the linked
+     one, with and without its index.
+     */
+    static TestResults* test5() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        pointsPossible++;
+        int mismatches = countModelMismatches(new ArrayList<int>(), 24680, 2000);
+        if (mismatches == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "unindexed ArrayList disagreed with the expected data " << mismatches << " times" << std::endl;
+        }
+        pointsPossible++;
+        ArrayList<int>* indexed = new ArrayList<int>();
+        indexed->enableIndex();
+        mismatches = countModelMismatches(indexed, 13579, 2000);
+        if (mismatches == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "indexed ArrayList disagreed with the expected data " << mismatches << " times" << std::endl;
+        }
+        // iteration and out of range positions
+        pointsPossible++;
+        ArrayList<int>* list = new ArrayList<int>();
+        int* values = new int[5];
+        for (int k = 0; k < 5; k++) {
+            values[k] = k;
+            list->insertAtEnd(&values[k]);
+        }
+        int k = 0;
+        bool inOrder = true;
+        for (int* item : *list) {
+            inOrder = inOrder && item == &values[k];
+            k++;
+        }
+        if (inOrder && k == 5 && list->peek(5) == nullptr && list->peek(-1) == nullptr) {
+            pointsEarned++;
+        }
+        else {
+            sout << "ArrayList iteration or bounds checking failed" << std::endl;
+        }
+        std::cout << "ChainTester::test5 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Test the unrolled list against the same operations as the linked one,
+     with a small chunk size so chunks split and merge often.
+     */
+    static TestResults* test6() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        pointsPossible++;
+        int mismatches = countModelMismatches(new UnrolledList<int, 4>(), 97531, 3000);
+        if (mismatches == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "unindexed UnrolledList disagreed with the expected data " << mismatches << " times" << std::endl;
+        }
+        pointsPossible++;
+        UnrolledList<int, 2>* indexed = new UnrolledList<int, 2>();
+        indexed->enableIndex();
+        mismatches = countModelMismatches(indexed, 8642, 3000);
+        if (mismatches == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "indexed UnrolledList disagreed with the expected data " << mismatches << " times" << std::endl;
+        }
+        // appending elements fills chunks before starting new ones, and
+        // iteration runs both ways
+        pointsPossible++;
+        UnrolledList<int, 16>* list = new UnrolledList<int, 16>();
+        int* values = new int[40];
+        for (int k = 0; k < 40; k++) {
+            values[k] = k;
+            list->insertAtEnd(&values[k]);
+        }
+        int k = 39;
+        bool inOrder = true;
+        for (UnrolledList<int, 16>::ReverseIterator it = list->rbegin(); it != list->rend(); ++it) {
+            inOrder = inOrder && *it == &values[k];
+            k--;
+        }
+        if (inOrder && k == -1 && list->getNumChunks() == 3) {
+            pointsEarned++;
+        }
+        else {
+            sout << "UnrolledList iteration or chunking failed" << std::endl;
+        }
+        std::cout << "ChainTester::test6 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Test the handle operations: insertAfter, insertBefore, erase and
+     splice, and check that the cursor survives a run of removals.
+     */
+    static TestResults* test7() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        int* values = new int[20];
+        for (int k = 0; k < 20; k++) {
+            values[k] = k;
+        }
+        // build 0, 2, 4, 6, 8 and fill in the odd values through handles
+        List<int, PooledNodeAllocator>* list = new List<int, PooledNodeAllocator>();
+        for (int k = 0; k < 10; k += 2) {
+            list->insertAtEnd(&values[k]);
+        }
+        Node<int>* handle = list->getHandle(0);
+        while (handle != nullptr) {
+            int value = *handle->getData();
+            Node<int>* next = handle->getNextNode();
+            list->insertAfter(handle, &values[value + 1]);
+            handle = next;
+        }
+        pointsPossible++;
+        bool inOrder = list->getSize() == 10;
+        for (int k = 0; k < 10; k++) {
+            inOrder = inOrder && list->peek(k) == &values[k];
+        }
+        if (inOrder) {
+            pointsEarned++;
+        }
+        else {
+            sout << "insertAfter did not insert in the correct positions" << std::endl;
+        }
+        // erase every multiple of three through iterator handles
+        List<int, PooledNodeAllocator>::Iterator it = list->begin();
+        while (it != list->end()) {
+            Node<int>* node = it.getNode();
+            ++it;
+            if (*node->getData() % 3 == 0) {
+                list->erase(node);
+            }
+        }
+        pointsPossible++;
+        int expectedAfterErase[6] = { 1, 2, 4, 5, 7, 8 };
+        inOrder = list->getSize() == 6;
+        for (int k = 0; k < 6 && inOrder; k++) {
+            inOrder = *list->peek(k) == expectedAfterErase[k];
+        }
+        if (inOrder) {
+            pointsEarned++;
+        }
+        else {
+            sout << "erase did not remove the correct nodes" << std::endl;
+        }
+        // insertBefore, and splice into the middle
+        list->insertBefore(list->getHandle(0), &values[0]);
+        List<int, PooledNodeAllocator>* other = new List<int, PooledNodeAllocator>();
+        other->insertAtEnd(&values[10]);
+        other->insertAtEnd(&values[11]);
+        list->splice(list->getHandle(2), other);
+        pointsPossible++;
+        int expectedAfterSplice[9] = { 0, 1, 2, 10, 11, 4, 5, 7, 8 };
+        inOrder = list->getSize() == 9 && other->isEmpty();
+        for (int k = 0; k < 9 && inOrder; k++) {
+            inOrder = *list->peek(k) == expectedAfterSplice[k];
+        }
+        if (inOrder) {
+            pointsEarned++;
+        }
+        else {
+            sout << "insertBefore or splice produced an incorrect list" << std::endl;
+        }
+        // removing from the same position repeatedly keeps the cursor there
+        pointsPossible++;
+        List<int, PooledNodeAllocator>* longList = new List<int, PooledNodeAllocator>();
+        for (int k = 0; k < 20; k++) {
+            longList->insertAtEnd(&values[k]);
+        }
+        bool correct = true;
+        for (int k = 0; k < 10; k++) {
+            correct = correct && longList->removeFromPosition(5) == &values[5 + k];
+            correct = correct && longList->peek(5) == &values[6 + k];
+        }
+        if (correct && longList->getSize() == 10) {
+            pointsEarned++;
+        }
+        else {
+            sout << "removeFromPosition returned incorrect data" << std::endl;
+        }
+        std::cout << "ChainTester::test7 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    static TestResults* test8() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        int* values = new int[1000];
+        for (int k = 0; k < 1000; k++) {
+            values[k] = k;
+        }
+        pointsPossible++;
+        if (rangeInsertMatches<List<int, PooledNodeAllocator>>(values)) {
+            pointsEarned++;
+        }
+        else {
+            sout << "range insertion into the linked list failed" << std::endl;
+        }
+        pointsPossible++;
+        if (rangeInsertMatches<ArrayList<int>>(values)) {
+            pointsEarned++;
+        }
+        else {
+            sout << "range insertion into the contiguous list failed" << std::endl;
+        }
+        pointsPossible++;
+        if (rangeInsertMatches<UnrolledList<int, 4>>(values)) {
+            pointsEarned++;
+        }
+        else {
+            sout << "range insertion into the unrolled list failed" << std::endl;
+        }
+        // a pooled batch of known length needs at most one block
+        pointsPossible++;
+        std::vector<int*> pointers;
+        for (int k = 0; k < 1000; k++) {
+            pointers.push_back(&values[k]);
+        }
+        long allocationsBefore = SystemAllocationCounter::getCount();
+        List<int, PooledNodeAllocator>* batch = new List<int, PooledNodeAllocator>(pointers.begin(), pointers.end());
+        long allocations = SystemAllocationCounter::getCount() - allocationsBefore;
+        if (allocations <= 1 && batch->getSize() == 1000 && batch->peek(999) == &values[999]) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a batch of 1000 nodes took " << allocations << " system allocations" << std::endl;
+        }
+        std::cout << "ChainTester::test8 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    static TestResults* test9() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        int liveBefore = Tracked::numLive();
+        ValueList<Tracked>* list = new ValueList<Tracked>();
+        // emplace, move-insert and insert at a position
+        list->emplaceAtEnd(2);
+        Tracked three(3);
+        list->insertAtEnd(std::move(three));
+        list->insertAtStart(Tracked(0));
+        list->emplaceAtPosition(1, 1);
+        pointsPossible++;
+        bool correct = list->getSize() == 4 && three.movedFrom;
+        for (int k = 0; k < 4 && correct; k++) {
+            correct = list->peek(k)->value == k && list->getIndex(Tracked(k)) == k;
+        }
+        if (correct && list->peek(4) == nullptr && list->getIndex(Tracked(9)) < 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "insertion or emplacement produced an incorrect list" << std::endl;
+        }
+        // removal destroys the elements
+        pointsPossible++;
+        correct = list->removeFromPosition(1) && list->removeFromStart() && list->removeFromEnd();
+        correct = correct && !list->removeFromPosition(5) && list->getSize() == 1 && list->peek(0)->value == 2;
+        if (correct && Tracked::numLive() == liveBefore + 2) {
+            pointsEarned++;
+        }
+        else {
+            sout << "removal did not destroy the removed elements" << std::endl;
+        }
+        // deleting the list destroys the rest
+        pointsPossible++;
+        delete list;
+        if (Tracked::numLive() == liveBefore + 1) {
+            pointsEarned++;
+        }
+        else {
+            sout << "deleting the list did not destroy its elements" << std::endl;
+        }
+        // construction from an initializer list, and iteration by reference
+        pointsPossible++;
+        ValueList<std::string> strings({ "a", "b", "c" });
+        std::string joined;
+        for (std::string& item : strings) {
+            joined += item;
+        }
+        strings.assign({ "d" });
+        if (joined == "abc" && strings.getSize() == 1 && *strings.peek(0) == "d") {
+            pointsEarned++;
+        }
+        else {
+            sout << "initializer list construction or assign failed" << std::endl;
+        }
+        std::cout << "ChainTester::test9 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    static TestResults* test10() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        int* values = new int[20];
+        for (int k = 0; k < 20; k++) {
+            values[k] = k;
+        }
+        NodePool<Node<int>>& pool = NodePool<Node<int>>::getInstance();
+        long inUseBefore = pool.getNumInUse();
+        List<int, PooledNodeAllocator>* list = new List<int, PooledNodeAllocator>();
+        for (int k = 0; k < 20; k++) {
+            list->insertAtEnd(&values[k]);
+        }
+        // a copy holds the same data pointers in new nodes
+        pointsPossible++;
+        List<int, PooledNodeAllocator>* copy = new List<int, PooledNodeAllocator>(*list);
+        bool correct = copy->getSize() == 20 && pool.getNumInUse() == inUseBefore + 40;
+        for (int k = 0; k < 20 && correct; k++) {
+            correct = copy->peek(k) == &values[k] && copy->getHandle(k) != list->getHandle(k);
+        }
+        if (correct) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the copy constructor did not copy the list" << std::endl;
+        }
+        // a move takes the nodes, and assignment releases the old ones
+        pointsPossible++;
+        List<int, PooledNodeAllocator> moved(std::move(*copy));
+        *copy = moved;
+        moved = std::move(*list);
+        correct = list->isEmpty() && moved.getSize() == 20 && copy->getSize() == 20;
+        if (correct && pool.getNumInUse() == inUseBefore + 40) {
+            pointsEarned++;
+        }
+        else {
+            sout << "move or assignment lost or leaked nodes" << std::endl;
+        }
+        // append takes over the nodes of the suffix
+        pointsPossible++;
+        List<int, PooledNodeAllocator>* suffix = copy->splitAfter(9);
+        copy->append(suffix);
+        correct = suffix->isEmpty() && copy->getSize() == 20 && *copy->peek(19) == 19;
+        delete suffix;
+        if (correct && pool.getNumInUse() == inUseBefore + 40) {
+            pointsEarned++;
+        }
+        else {
+            sout << "append did not leave the suffix empty" << std::endl;
+        }
+        // destruction releases every node
+        pointsPossible++;
+        delete copy;
+        delete list;
+        moved.clear();
+        if (pool.getNumInUse() == inUseBefore && moved.isEmpty()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "destruction left " << pool.getNumInUse() - inUseBefore << " nodes in use" << std::endl;
+        }
+        // the other backends copy too
+        pointsPossible++;
+        UnrolledList<int, 4> unrolled({ &values[0], &values[1], &values[2], &values[3], &values[4] });
+        UnrolledList<int, 4> unrolledCopy(unrolled);
+        ArrayList<int> array({ &values[0], &values[1] });
+        ArrayList<int> arrayCopy(array);
+        unrolled.clear();
+        array.clear();
+        if (unrolledCopy.getSize() == 5 && unrolledCopy.peek(4) == &values[4] && arrayCopy.getSize() == 2 && unrolled.isEmpty()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "copying an unrolled or contiguous list failed" << std::endl;
+        }
+        delete[] values;
+        std::cout << "ChainTester::test10 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    static TestResults* test11() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        const int numProducers = 4;
+        const int numPerProducer = 20000;
+        // producer p pushes the values p * numPerProducer + k, in order
+        int* values = new int[numProducers * numPerProducer];
+        for (int k = 0; k < numProducers * numPerProducer; k++) {
+            values[k] = k;
+        }
+        MPSCQueue<int>* queue = new MPSCQueue<int>();
+        pointsPossible++;
+        if (queue->isEmpty() && queue->pop() == nullptr && queue->peek() == nullptr) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a new queue was not empty" << std::endl;
+        }
+        std::vector<std::thread> producers;
+        for (int p = 0; p < numProducers; p++) {
+            producers.push_back(std::thread([queue, values, p, numPerProducer]() {
+                for (int k = 0; k < numPerProducer; k++) {
+                    queue->push(&values[p * numPerProducer + k]);
+                }
+            }));
+        }
+        // consume concurrently, checking every value arrives once and in
+        // order for its producer
+        std::vector<int> nextExpected(numProducers, 0);
+        int numPopped = 0;
+        bool inOrder = true;
+        while (numPopped < numProducers * numPerProducer) {
+            int* data = queue->pop();
+            if (data != nullptr) {
+                int p = *data / numPerProducer;
+                inOrder = inOrder && *data % numPerProducer == nextExpected[p];
+                nextExpected[p]++;
+                numPopped++;
+            }
+        }
+        for (std::thread& producer : producers) {
+            producer.join();
+        }
+        pointsPossible++;
+        if (inOrder && queue->isEmpty()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "concurrent pushes were lost, duplicated or reordered" << std::endl;
+        }
+        // single-threaded FIFO behaviour, and destruction with data left in
+        pointsPossible++;
+        queue->push(&values[1]);
+        queue->push(&values[2]);
+        bool correct = queue->peek() == &values[1] && queue->pop() == &values[1];
+        correct = correct && queue->pop() == &values[2] && queue->pop() == nullptr;
+        queue->push(&values[3]);
+        if (correct) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the queue did not pop in FIFO order" << std::endl;
+        }
+        delete queue;
+        delete[] values;
+        std::cout << "ChainTester::test11 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    static TestResults* test12() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        int* values = new int[100];
+        for (int k = 0; k < 100; k++) {
+            values[k] = k;
+        }
+        // mixed operations at both ends of a deque, against a vector
+        pointsPossible++;
+        Deque<int>* deque = new Deque<int>();
+        std::vector<int*> model;
+        unsigned int seed = 17;
+        int numMismatches = 0;
+        for (int step = 0; step < 2000; step++) {
+            seed = seed * 1103515245 + 12345;
+            int* data = &values[(seed >> 8) % 100];
+            switch ((seed >> 16) % 4) {
+            case 0:
+                deque->insertAtStart(data);
+                model.insert(model.begin(), data);
+                break;
+            case 1:
+                deque->insertAtEnd(data);
+                model.push_back(data);
+                break;
+            case 2:
+                if (deque->removeFromStart() != (model.empty() ? nullptr : model.front())) {
+                    numMismatches++;
+                }
+                if (!model.empty()) {
+                    model.erase(model.begin());
+                }
+                break;
+            default:
+                if (deque->removeFromEnd() != (model.empty() ? nullptr : model.back())) {
+                    numMismatches++;
+                }
+                if (!model.empty()) {
+                    model.pop_back();
+                }
+                break;
+            }
+            if (deque->getSize() != static_cast<int>(model.size())) {
+                numMismatches++;
+            }
+            else if (!model.empty()) {
+                int position = static_cast<int>((seed >> 4) % model.size());
+                if (deque->peek(position) != model[position]) {
+                    numMismatches++;
+                }
+            }
+        }
+        int position = 0;
+        for (int* data : *deque) {
+            if (data != model[position++]) {
+                numMismatches++;
+            }
+        }
+        if (numMismatches == 0 && (deque->getCapacity() & (deque->getCapacity() - 1)) == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the deque disagreed with the model " << numMismatches << " times" << std::endl;
+        }
+        // the buffer stops growing once it reaches the working size
+        pointsPossible++;
+        Queue<int> queue;
+        for (int k = 0; k < 50; k++) {
+            queue.enqueue(&values[k]);
+        }
+        Deque<int> copy(*deque);
+        bool correct = copy.getSize() == deque->getSize() && copy.peekFront() == deque->peekFront();
+        int capacityBefore = deque->getCapacity();
+        for (int k = 0; k < 10000; k++) {
+            deque->insertAtEnd(deque->removeFromStart());
+            int* data = queue.dequeue();
+            correct = correct && data == &values[k % 50];
+            queue.enqueue(data);
+        }
+        if (correct && deque->getCapacity() == capacityBefore && queue.getSize() == 50) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the queue lost its order, or the buffer grew in steady state" << std::endl;
+        }
+        // stacks pop in reverse order
+        pointsPossible++;
+        Stack<int> stack;
+        for (int k = 0; k < 20; k++) {
+            stack.push(&values[k]);
+        }
+        correct = stack.peek() == &values[19] && stack.getSize() == 20;
+        for (int k = 19; k >= 0; k--) {
+            correct = correct && stack.pop() == &values[k];
+        }
+        if (correct && stack.isEmpty() && stack.pop() == nullptr && stack.peek() == nullptr) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the stack did not pop in LIFO order" << std::endl;
+        }
+        delete deque;
+        delete[] values;
+        std::cout << "ChainTester::test12 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     test SortedList against a vector kept sorted, with many equivalent
+     values so that ties must keep their insertion order
+     */
+    static TestResults* test13() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        int* values = new int[200];
+        for (int k = 0; k < 200; k++) {
+            values[k] = k % 25;
+        }
+        // an empty list
+        pointsPossible++;
+        SortedList<int>* list = new SortedList<int>();
+        if (list->isEmpty() && list->peek(0) == nullptr && list->find(3) == nullptr && list->getIndex(&values[3]) < 0
+            && !list->remove(&values[3]) && list->removeFromStart() == nullptr) {
+            pointsEarned++;
+        }
+        else {
+            sout << "an empty sorted list reported an element" << std::endl;
+        }
+        // random insertions and removals, against a model
+        pointsPossible++;
+        std::vector<int*> model;
+        unsigned int seed = 29;
+        int numMismatches = 0;
+        for (int step = 0; step < 4000; step++) {
+            seed = seed * 1103515245 + 12345;
+            int* data = &values[(seed >> 8) % 200];
+            std::vector<int*>::iterator found = std::find(model.begin(), model.end(), data);
+            if ((seed >> 16) % 5 < 2 && !model.empty()) {
+                int position = static_cast<int>((seed >> 4) % model.size());
+                if (list->removeFromPosition(position) != model[position]) {
+                    numMismatches++;
+                }
+                model.erase(model.begin() + position);
+            }
+            else if (found != model.end()) {
+                if (!list->remove(data)) {
+                    numMismatches++;
+                }
+                model.erase(found);
+            }
+            else {
+                std::vector<int*>::iterator place = std::upper_bound(model.begin(), model.end(), data,
+                    [](int* a, int* b) { return *a < *b; });
+                int position = static_cast<int>(place - model.begin());
+                if (list->insert(data) != position) {
+                    numMismatches++;
+                }
+                model.insert(place, data);
+            }
+            if (list->getSize() != static_cast<int>(model.size())) {
+                numMismatches++;
+            }
+            else if (!model.empty()) {
+                int position = static_cast<int>((seed >> 12) % model.size());
+                if (list->peek(position) != model[position] || list->getIndex(model[position]) != position) {
+                    numMismatches++;
+                }
+            }
+        }
+        int position = 0;
+        for (int* data : *list) {
+            if (position >= static_cast<int>(model.size()) || data != model[position++]) {
+                numMismatches++;
+            }
+        }
+        if (numMismatches == 0 && position == static_cast<int>(model.size())) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the sorted list disagreed with the model " << numMismatches << " times" << std::endl;
+        }
+        // find and lowerBound locate the first of a run of equivalent values
+        pointsPossible++;
+        list->clear();
+        for (int k = 0; k < 200; k++) {
+            list->insert(&values[k]);
+        }
+        int seven = 7;
+        int late = 30;
+        bool correct = list->find(seven) == &values[7] && list->lowerBound(seven) == 56 && list->find(late) == nullptr;
+        correct = correct && list->lowerBound(late) == 200 && list->getIndex(&values[32]) == 57;
+        if (correct && list->removeFromEnd() == &values[199] && list->removeFromStart() == &values[0]) {
+            pointsEarned++;
+        }
+        else {
+            sout << "find or lowerBound did not locate the first equivalent value" << std::endl;
+        }
+        // copies are independent of the original
+        pointsPossible++;
+        SortedList<int> copy(*list);
+        list->clear();
+        if (list->isEmpty() && copy.getSize() == 198 && copy.peek(0) == &values[25] && copy.peek(197) == &values[174]) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a copied sorted list lost its order" << std::endl;
+        }
+        delete list;
+        delete[] values;
+        std::cout << "ChainTester::test13 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Fills the specified list with pseudo-random data pointers, sorts it in
+     descending order, and returns true if and only if it matches a stable
+     sort of the same pointers.
+     */
+    template <typename ListType>
+    static bool sortsLikeStableSort(ListType* list, int* values, int numValues, unsigned int seed) {
+        std::vector<int*> model;
+        for (int k = 0; k < numValues; k++) {
+            seed = seed * 1103515245 + 12345;
+            int* data = &values[(seed >> 8) % numValues];
+            list->insertAtEnd(data);
+            model.push_back(data);
+        }
+        std::stable_sort(model.begin(), model.end(), [](int* a, int* b) { return *a > *b; });
+        list->sort(std::greater<int>());
+        bool result = list->getSize() == numValues;
+        int position = 0;
+        for (int* data : *list) {
+            result = result && data == model[position++];
+        }
+        return result && list->peek(numValues - 1) == model.back() && list->getIndex(model[0]) == 0;
+    }
+
+    /*
+     test sort on each storage policy, including a contiguous list large
+     enough to be sorted in parallel
+     */
+    static TestResults* test14() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        int numValues = 200000;
+        int* values = new int[numValues];
+        for (int k = 0; k < numValues; k++) {
+            // few distinct values, so stability matters
+            values[k] = k % 101;
+        }
+        // the linked list relinks its nodes, and its handles follow their data
+        pointsPossible++;
+        List<int, PooledNodeAllocator>* linked = new List<int, PooledNodeAllocator>();
+        linked->enableIndex();
+        bool correct = sortsLikeStableSort(linked, values, 5000, 3);
+        Node<int>* handle = linked->getHandle(2500);
+        int* handleData = handle->getData();
+        linked->sort();
+        correct = correct && handle->getData() == handleData && linked->getIndex(handleData) >= 0;
+        int previous = 0;
+        for (int* data : *linked) {
+            correct = correct && *data >= previous;
+            previous = *data;
+        }
+        if (correct) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the linked list did not sort stably" << std::endl;
+        }
+        delete linked;
+        // the contiguous list, sorted in slices on several threads
+        pointsPossible++;
+        List<int, ContiguousStorage>* contiguous = new List<int, ContiguousStorage>();
+        if (sortsLikeStableSort(contiguous, values, numValues, 5)) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the contiguous list did not sort stably" << std::endl;
+        }
+        delete contiguous;
+        // the unrolled list
+        pointsPossible++;
+        List<int, UnrolledStorage<8>>* unrolled = new List<int, UnrolledStorage<8>>();
+        correct = sortsLikeStableSort(unrolled, values, 3000, 11);
+        int numChunks = unrolled->getNumChunks();
+        unrolled->sort();
+        if (correct && unrolled->getNumChunks() == numChunks && *unrolled->peek(0) == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the unrolled list did not sort stably" << std::endl;
+        }
+        delete unrolled;
+        delete[] values;
+        std::cout << "ChainTester::test14 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     test SmallList: inline storage, spilling to the heap, indexed lookups,
+     removal, and copying and moving in both states
+     */
+    static TestResults* test15() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        int* values = new int[100];
+        for (int k = 0; k < 100; k++) {
+            values[k] = k;
+        }
+        // a short list stays inline
+        pointsPossible++;
+        SmallList<int, 4>* list = new SmallList<int, 4>();
+        list->enableIndex(8);
+        for (int k = 0; k < 4; k++) {
+            list->insertAtEnd(&values[k]);
+        }
+        bool correct = list->isInline() && list->getSize() == 4 && list->peek(3) == &values[3] && list->peek(4) == nullptr;
+        if (correct && list->getIndex(&values[2]) == 2 && list->getIndex(&values[50]) < 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a list within its inline capacity misbehaved" << std::endl;
+        }
+        // a long list spills, and keeps its order and index through removals
+        pointsPossible++;
+        std::vector<int*> model(list->begin(), list->end());
+        for (int k = 4; k < 100; k++) {
+            list->insertAtEnd(&values[k]);
+            model.push_back(&values[k]);
+        }
+        unsigned int seed = 41;
+        int numMismatches = 0;
+        for (int step = 0; step < 60; step++) {
+            seed = seed * 1103515245 + 12345;
+            int position = static_cast<int>((seed >> 8) % model.size());
+            if (list->removeFromPosition(position) != model[position]) {
+                numMismatches++;
+            }
+            model.erase(model.begin() + position);
+            int probe = static_cast<int>((seed >> 16) % model.size());
+            if (list->getIndex(model[probe]) != probe) {
+                numMismatches++;
+            }
+        }
+        if (numMismatches == 0 && !list->isInline() && list->getSize() == 40 && list->removeFromEnd() == model.back()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a spilled list disagreed with the model " << numMismatches << " times" << std::endl;
+        }
+        // copies and moves, from inline and from spilled lists
+        pointsPossible++;
+        SmallList<int, 4> spilledCopy(*list);
+        SmallList<int, 4> spilledMove(std::move(*list));
+        SmallList<int, 4> inlineList;
+        inlineList.insertAtEnd(&values[7]);
+        SmallList<int, 4> inlineMove(std::move(inlineList));
+        correct = spilledCopy.getSize() == 39 && spilledMove.getSize() == 39 && list->isEmpty() && list->isInline();
+        correct = correct && spilledCopy.peek(38) == spilledMove.peek(38) && spilledCopy.begin() != spilledMove.begin();
+        correct = correct && inlineMove.isInline() && inlineMove.peek(0) == &values[7] && inlineList.isEmpty();
+        inlineList = spilledMove;
+        spilledMove.clear();
+        if (correct && inlineList.getSize() == 39 && spilledMove.isEmpty() && spilledMove.isInline()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "copying or moving a small list went wrong" << std::endl;
+        }
+        delete list;
+        delete[] values;
+        std::cout << "ChainTester::test15 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     test PersistentList: random updates against a vector, with snapshots
+     taken along the way that must keep their own versions
+     */
+    static TestResults* test16() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        int* values = new int[100];
+        for (int k = 0; k < 100; k++) {
+            values[k] = k;
+        }
+        // built from a range, a list is balanced and in order
+        pointsPossible++;
+        PersistentList<int>* list = new PersistentList<int>();
+        bool correct = list->isEmpty() && list->peek(0) == nullptr && list->removeFromEnd() == nullptr;
+        std::vector<int*> model;
+        for (int k = 0; k < 100; k++) {
+            model.push_back(&values[k]);
+        }
+        *list = PersistentList<int>(model.begin(), model.end());
+        int position = 0;
+        for (int* data : *list) {
+            correct = correct && data == model[position++];
+        }
+        if (correct && list->getSize() == 100 && list->getIndex(&values[64]) == 64) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a persistent list built from a range was wrong" << std::endl;
+        }
+        // random updates, against a model
+        pointsPossible++;
+        std::vector<PersistentList<int>> snapshots;
+        std::vector<std::vector<int*>> snapshotModels;
+        unsigned int seed = 53;
+        int numMismatches = 0;
+        for (int step = 0; step < 3000; step++) {
+            seed = seed * 1103515245 + 12345;
+            int* data = &values[(seed >> 8) % 100];
+            int where = model.empty() ? 0 : static_cast<int>((seed >> 4) % model.size());
+            switch ((seed >> 16) % 6) {
+            case 0:
+                list->insertAtStart(data);
+                model.insert(model.begin(), data);
+                break;
+            case 1:
+                list->insertAtEnd(data);
+                model.push_back(data);
+                break;
+            case 2:
+                list->insertAtPosition(where, data);
+                model.insert(model.begin() + where, data);
+                break;
+            case 3:
+                if (list->removeFromPosition(where) != (model.empty() ? nullptr : model[where])) {
+                    numMismatches++;
+                }
+                if (!model.empty()) {
+                    model.erase(model.begin() + where);
+                }
+                break;
+            case 4:
+                if (list->removeFromStart() != (model.empty() ? nullptr : model.front())) {
+                    numMismatches++;
+                }
+                if (!model.empty()) {
+                    model.erase(model.begin());
+                }
+                break;
+            default:
+                list->setData(data, where);
+                if (!model.empty()) {
+                    model[where] = data;
+                }
+                break;
+            }
+            if (list->getSize() != static_cast<int>(model.size())) {
+                numMismatches++;
+            }
+            else if (!model.empty()) {
+                int probe = static_cast<int>((seed >> 12) % model.size());
+                if (list->peek(probe) != model[probe]) {
+                    numMismatches++;
+                }
+            }
+            if (step % 100 == 0) {
+                snapshots.push_back(list->snapshot());
+                snapshotModels.push_back(model);
+            }
+        }
+        if (numMismatches == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the persistent list disagreed with the model " << numMismatches << " times" << std::endl;
+        }
+        // every snapshot still holds the version it was taken from
+        pointsPossible++;
+        correct = true;
+        for (int k = 0; k < static_cast<int>(snapshots.size()); k++) {
+            std::vector<int*> items(snapshots[k].begin(), snapshots[k].end());
+            correct = correct && items == snapshotModels[k];
+        }
+        PersistentList<int> copy(*list);
+        correct = correct && copy.isSameVersion(*list);
+        list->clear();
+        if (correct && !copy.isSameVersion(*list) && copy.getSize() == static_cast<int>(model.size())) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a snapshot changed after it was taken" << std::endl;
+        }
+        delete list;
+        delete[] values;
+        std::cout << "ChainTester::test16 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     Fills the specified list with pseudo-random data pointers, then applies
+     removeIf, removeAll and retainIf to it and to a vector. Returns the
+     number of disagreements, checking the contents, the counts returned,
+     getIndex, and that the list still works at both ends afterwards.
+     */
+    template <typename ListType>
+    static int countFilterMismatches(ListType* list, int* values, int numValues, unsigned int seed) {
+        std::vector<int*> model;
+        for (int k = 0; k < 500; k++) {
+            seed = seed * 1103515245 + 12345;
+            int* data = &values[(seed >> 8) % numValues];
+            list->insertAtEnd(data);
+            model.push_back(data);
+        }
+        int numMismatches = 0;
+        std::vector<int*>::iterator kept;
+        // drop the even values
+        kept = std::remove_if(model.begin(), model.end(), [](int* data) { return *data % 2 == 0; });
+        if (list->removeIf([](int* data) { return *data % 2 == 0; }) != model.end() - kept) {
+            numMismatches++;
+        }
+        model.erase(kept, model.end());
+        // drop every copy of the first remaining value
+        int* first = model.front();
+        kept = std::remove(model.begin(), model.end(), first);
+        if (list->removeAll(first) != model.end() - kept || list->getIndex(first) >= 0) {
+            numMismatches++;
+        }
+        model.erase(kept, model.end());
+        // keep the values below 30
+        kept = std::remove_if(model.begin(), model.end(), [](int* data) { return *data >= 30; });
+        if (list->retainIf([](int* data) { return *data < 30; }) != model.end() - kept) {
+            numMismatches++;
+        }
+        model.erase(kept, model.end());
+        list->insertAtEnd(&values[1]);
+        model.push_back(&values[1]);
+        list->insertAtStart(&values[3]);
+        model.insert(model.begin(), &values[3]);
+        if (list->getSize() != static_cast<int>(model.size())) {
+            numMismatches++;
+        }
+        int position = 0;
+        for (int* data : *list) {
+            if (position >= static_cast<int>(model.size()) || data != model[position]) {
+                numMismatches++;
+            }
+            else if (list->getIndex(data) != static_cast<int>(std::find(model.begin(), model.end(), data) - model.begin())) {
+                numMismatches++;
+            }
+            position++;
+        }
+        position = static_cast<int>(model.size());
+        for (typename ListType::ReverseIterator it = list->rbegin(); it != list->rend(); ++it) {
+            if (*it != model[--position]) {
+                numMismatches++;
+            }
+        }
+        if (list->removeIf([](int*) { return true; }) != static_cast<int>(model.size()) || !list->isEmpty()) {
+            numMismatches++;
+        }
+        return numMismatches;
+    }
+
+    /*
+     test removeIf, removeAll and retainIf on each storage policy
+     */
+    static TestResults* test17() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        int* values = new int[60];
+        for (int k = 0; k < 60; k++) {
+            values[k] = k;
+        }
+        pointsPossible++;
+        List<int, PooledNodeAllocator>* linked = new List<int, PooledNodeAllocator>();
+        linked->enableIndex();
+        int numMismatches = countFilterMismatches(linked, values, 60, 61);
+        if (numMismatches == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "filtering the linked list gave " << numMismatches << " mismatches" << std::endl;
+        }
+        delete linked;
+        pointsPossible++;
+        List<int, ContiguousStorage>* contiguous = new List<int, ContiguousStorage>();
+        contiguous->enableIndex();
+        numMismatches = countFilterMismatches(contiguous, values, 60, 67);
+        if (numMismatches == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "filtering the contiguous list gave " << numMismatches << " mismatches" << std::endl;
+        }
+        delete contiguous;
+        pointsPossible++;
+        List<int, UnrolledStorage<8>>* unrolled = new List<int, UnrolledStorage<8>>();
+        unrolled->enableIndex();
+        numMismatches = countFilterMismatches(unrolled, values, 60, 71);
+        if (numMismatches == 0 && unrolled->getNumChunks() == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "filtering the unrolled list gave " << numMismatches << " mismatches" << std::endl;
+        }
+        delete unrolled;
+        delete[] values;
+        std::cout << "ChainTester::test17 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     An element type used only by test18, so that the registry's totals for
+     it come from that test alone.
+     */
+    struct StatsProbe {
+        int value;
+    };
+
+    /*
+     test list statistics: node counts always, and the counters and the
+     registry when they are compiled in
+     */
+    static TestResults* test18() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        StatsProbe* probes = new StatsProbe[100];
+        List<StatsProbe, PooledNodeAllocator>* list = new List<StatsProbe, PooledNodeAllocator>();
+        for (int k = 0; k < 100; k++) {
+            list->insertAtEnd(&probes[k]);
+        }
+        list->removeFromEnd();
+        // walk to position 10 from the start, then 5 more from the cursor
+        list->peek(10);
+        list->setData(&probes[0], 15);
+        // scan 20 nodes before finding the data
+        list->getIndex(&probes[20]);
+        ListStatistics stats = list->getStatistics();
+        ListStatistics totals = ListStatsRegistry::getTotals(typeid(StatsProbe).name());
+        // the chain always knows its nodes
+        pointsPossible++;
+        if (stats.numNodes == 99 && stats.bytesInUse == 99 * static_cast<long>(sizeof(Node<StatsProbe>))) {
+            pointsEarned++;
+        }
+        else {
+            sout << "getStatistics reported " << stats.toString() << std::endl;
+        }
+        // the counters, and the totals for the element type
+        pointsPossible++;
+        bool correct;
+        if (List<StatsProbe, PooledNodeAllocator>::statisticsEnabled()) {
+            correct = stats.numAllocations == 100 && stats.numFrees == 1;
+            correct = correct && stats.peekHops == 10 && stats.setDataHops == 5 && stats.indexHops == 20;
+            correct = correct && totals.numNodes == 99 && totals.peekHops == 10 && totals.indexHops == 20;
+            List<StatsProbe, PooledNodeAllocator> copy(*list);
+            correct = correct && copy.getStatistics().numAllocations == 99;
+            correct = correct && ListStatsRegistry::getTotals(typeid(StatsProbe).name()).numNodes == 198;
+            correct = correct && ListStatsRegistry::toString().find(typeid(StatsProbe).name()) != std::string::npos;
+        }
+        else {
+            correct = stats.numAllocations == 0 && stats.peekHops == 0 && totals.numAllocations == 0;
+            correct = correct && std::is_empty<ListStatsRecorder<StatsProbe>>::value;
+        }
+        if (correct) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the counters were wrong: " << stats.toString() << std::endl;
+        }
+        // rebuilding the index counts a walk over every node, and a change in
+        // the middle sends lookups back to scanning until the next rebuild
+        pointsPossible++;
+        List<StatsProbe, PooledNodeAllocator>* indexed = new List<StatsProbe, PooledNodeAllocator>();
+        indexed->enableIndex();
+        for (int k = 0; k < 10; k++) {
+            indexed->insertAtEnd(&probes[k]);
+        }
+        // two scans of 3 hops, then a rebuild over 10 nodes, then a lookup
+        for (int k = 0; k < 4; k++) {
+            correct = indexed->getIndex(&probes[3]) == 3;
+        }
+        long hopsBeforeChange = indexed->getStatistics().indexHops;
+        indexed->insertAtPosition(5, &probes[50]);
+        // two scans of 5 hops, then a rebuild over 11 nodes, then a lookup
+        for (int k = 0; k < 4; k++) {
+            correct = correct && indexed->getIndex(&probes[50]) == 5;
+        }
+        long hopsAfterChange = indexed->getStatistics().indexHops;
+        if (List<StatsProbe, PooledNodeAllocator>::statisticsEnabled()) {
+            correct = correct && hopsBeforeChange == 16 && hopsAfterChange == 37;
+        }
+        else {
+            correct = correct && hopsAfterChange == 0;
+        }
+        if (correct) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the index hops were " << hopsBeforeChange << " and " << hopsAfterChange << std::endl;
+        }
+        delete indexed;
+        delete list;
+        delete[] probes;
+        std::cout << "ChainTester::test18 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     test the shared node pool from several threads: each thread builds and
+     tears down lists of its own, and lists built on one thread are freed
+     on another
+     */
+    static TestResults* test19() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        const int numThreads = 4;
+        int* values = new int[1000];
+        for (int k = 0; k < 1000; k++) {
+            values[k] = k;
+        }
+        long inUseBefore = NodePool<Node<int>>::getInstance().getNumInUse();
+        List<int, PooledNodeAllocator>* handedOver[numThreads];
+        bool correct[numThreads];
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; t++) {
+            threads.push_back(std::thread([t, values, &handedOver, &correct]() {
+                correct[t] = true;
+                for (int round = 0; round < 20; round++) {
+                    List<int, PooledNodeAllocator> linked;
+                    UnrolledList<int> unrolled;
+                    for (int k = 0; k < 1000; k++) {
+                        linked.insertAtEnd(&values[k]);
+                        unrolled.insertAtStart(&values[k]);
+                    }
+                    correct[t] = correct[t] && linked.peek(500) == &values[500] && unrolled.peek(0) == &values[999];
+                }
+                // the next thread frees this one
+                handedOver[t] = new List<int, PooledNodeAllocator>();
+                for (int k = 0; k < 100; k++) {
+                    handedOver[t]->insertAtEnd(&values[k]);
+                }
+            }));
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        threads.clear();
+        for (int t = 0; t < numThreads; t++) {
+            List<int, PooledNodeAllocator>* other = handedOver[(t + 1) % numThreads];
+            threads.push_back(std::thread([other]() {
+                delete other;
+            }));
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        pointsPossible++;
+        bool allCorrect = true;
+        for (int t = 0; t < numThreads; t++) {
+            allCorrect = allCorrect && correct[t];
+        }
+        if (allCorrect && NodePool<Node<int>>::getInstance().getNumInUse() == inUseBefore) {
+            pointsEarned++;
+        }
+        else {
+            sout << "lists built on several threads lost nodes or data" << std::endl;
+        }
+        delete[] values;
+        std::cout << "ChainTester::test19 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    static TestResults* runAllTests() {
+        int totalPossible = 0;
+        int totalEarned = 0;
+
+        TestResults* r;
+
+        r = test0();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test1();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test2();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test3();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test4();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test5();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test6();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test7();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test8();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test9();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test10();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test11();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test12();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test13();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test14();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test15();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test16();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test17();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test18();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test19();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        return new TestResults(totalPossible, totalEarned, "");
+    }
+
+};
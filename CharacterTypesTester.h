@@ -5,6 +5,7 @@
 #include <string>
 
 #include "CharacterTypes.h"
+#include "PlayerActions.h"
 #include "TestResults.h"
 
 class CharacterTypesTester {
@@ -363,6 +364,45 @@ public:
         return new TestResults(pointsPossible, pointsEarned, sout.str());
     }
 
+    /*
+     test that every action name converts to its action and back
+     */
+    static TestResults* test3() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        const char* names[3] = { "FallInLove", "Fight", "WalkTowards" };
+        PlayerActions::PlayerAction actions[3] = {
+            PlayerActions::PlayerAction::FallInLove,
+            PlayerActions::PlayerAction::Fight,
+            PlayerActions::PlayerAction::WalkTowards
+        };
+        for (int k = 0; k < 3; k++) {
+            pointsPossible++;
+            PlayerActions action(names[k]);
+            if (action.getAction() == actions[k] && action.toString() == names[k]) {
+                pointsEarned++;
+            }
+            else {
+                sout << "PlayerActions(\"" << names[k] << "\") gave " << action.toString() << std::endl;
+            }
+        }
+        pointsPossible++;
+        bool roundTrips = true;
+        for (int k = 0; k <= static_cast<int>(PlayerActions::PlayerAction::WalkTowards); k++) {
+            PlayerActions action(static_cast<PlayerActions::PlayerAction>(k));
+            roundTrips = roundTrips && PlayerActions(action.toString()) == action;
+        }
+        if (roundTrips && PlayerActions("NoSuchAction").getAction() == PlayerActions::PlayerAction::DoNothing) {
+            pointsEarned++;
+        }
+        else {
+            sout << "some action names did not convert back to their actions" << std::endl;
+        }
+        std::cout << "CharacterTypesTester::test3 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
     static TestResults* testX() {
         std::ostringstream sout;
         int pointsPossible = 0;
@@ -393,6 +433,11 @@ public:
         totalEarned += r->pointsEarned;
         std::cout << r->toString() << std::endl;
 
+        r = test3();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
         return new TestResults(totalPossible, totalEarned, "");
     }
 
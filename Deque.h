@@ -0,0 +1,324 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <utility>
+
+/*
+ A double-ended queue of data pointers, kept in a growable ring buffer.
+ Insertion and removal at either end take amortized O(1) time, and peek
+ takes O(1) time at any position. The capacity is always a power of two,
+ so positions wrap with a mask, and it only grows: once a deque has
+ reached its working size, pushes and pops allocate nothing.
+
+ Like the lists, a deque holds pointers to data it does not own. Stack and
+ Queue are adapters over it.
+ */
+template <typename T>
+class Deque {
+
+protected:
+
+    /*
+     Capacity of the first buffer a deque allocates.
+     */
+    static const int initialCapacity = 8;
+
+    /*
+     The ring buffer, its capacity (zero or a power of two), the position
+     in the buffer of the first element, and the number of elements.
+     */
+    T** buffer;
+    int capacity;
+    int head;
+    int numItems;
+
+    /*
+     Returns the buffer slot holding the element in the specified position.
+     */
+    int slot(int position) const {
+        return (this->head + position) & (this->capacity - 1);
+    }
+
+    /*
+     Moves the elements into a new buffer with at least the specified
+     capacity, rounded up to a power of two, with the first element in
+     slot 0.
+     */
+    void grow(int minimumCapacity) {
+        int newCapacity = this->capacity > 0 ? this->capacity : initialCapacity;
+        while (newCapacity < minimumCapacity) {
+            newCapacity *= 2;
+        }
+        T** newBuffer = new T*[newCapacity];
+        for (int k = 0; k < this->numItems; k++) {
+            newBuffer[k] = this->buffer[this->slot(k)];
+        }
+        delete[] this->buffer;
+        this->buffer = newBuffer;
+        this->capacity = newCapacity;
+        this->head = 0;
+    }
+
+public:
+
+    /*
+     A forward iterator over the elements of a deque, from front to back.
+     Dereferencing it yields the data pointer.
+     */
+    class Iterator {
+
+    protected:
+
+        Deque<T>* deque;
+        int position;
+
+    public:
+
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef T** pointer;
+        typedef T*& reference;
+
+        Iterator(Deque<T>* deque, int position) {
+            this->deque = deque;
+            this->position = position;
+        }
+
+        T*& operator*() const {
+            return this->deque->buffer[this->deque->slot(this->position)];
+        }
+
+        Iterator& operator++() {
+            this->position++;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator result = *this;
+            this->position++;
+            return result;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return this->deque == other.deque && this->position == other.position;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
+        }
+
+    };
+
+    typedef Iterator iterator;
+
+    /*
+     Creates an empty deque. No buffer is allocated until the first
+     insertion.
+     */
+    Deque() {
+        this->buffer = nullptr;
+        this->capacity = 0;
+        this->head = 0;
+        this->numItems = 0;
+    }
+
+    /*
+     Creates a deque holding the same data pointers as the specified one.
+     */
+    Deque(const Deque<T>& other) : Deque() {
+        if (other.numItems > 0) {
+            this->reserve(other.numItems);
+            for (int k = 0; k < other.numItems; k++) {
+                this->buffer[k] = other.buffer[other.slot(k)];
+            }
+            this->numItems = other.numItems;
+        }
+    }
+
+    /*
+     Creates a deque that takes over the buffer of the specified one,
+     leaving it empty.
+     */
+    Deque(Deque<T>&& other) : Deque() {
+        this->swap(other);
+    }
+
+    /*
+     Replaces the contents of this deque with a copy of, or the contents of,
+     the specified deque.
+     */
+    Deque<T>& operator=(Deque<T> other) {
+        this->swap(other);
+        return *this;
+    }
+
+    /*
+     Releases the buffer. The data is left alone.
+     */
+    ~Deque() {
+        delete[] this->buffer;
+    }
+
+    /*
+     Exchanges the contents of this deque and the specified one.
+     */
+    void swap(Deque<T>& other) {
+        std::swap(this->buffer, other.buffer);
+        std::swap(this->capacity, other.capacity);
+        std::swap(this->head, other.head);
+        std::swap(this->numItems, other.numItems);
+    }
+
+    /*
+     Makes sure this deque can hold the specified number of elements without
+     growing.
+     */
+    void reserve(int numElements) {
+        if (numElements > this->capacity) {
+            this->grow(numElements);
+        }
+    }
+
+    /*
+     Returns true if and only if this deque has no elements.
+     */
+    bool isEmpty() {
+        return this->numItems == 0;
+    }
+
+    /*
+     Returns the number of elements in this deque.
+     */
+    int getSize() {
+        return this->numItems;
+    }
+
+    /*
+     Returns the number of elements this deque can hold without growing.
+     */
+    int getCapacity() {
+        return this->capacity;
+    }
+
+    /*
+     Returns the data at the specified position, counting from the front,
+     or the null pointer if the position does not exist in this deque.
+     */
+    T* peek(int position) {
+        T* result = nullptr;
+        if (position >= 0 && position < this->numItems) {
+            result = this->buffer[this->slot(position)];
+        }
+        return result;
+    }
+
+    /*
+     Returns the data at the front of this deque, or the null pointer if it
+     is empty.
+     */
+    T* peekFront() {
+        return this->peek(0);
+    }
+
+    /*
+     Returns the data at the back of this deque, or the null pointer if it
+     is empty.
+     */
+    T* peekBack() {
+        return this->peek(this->numItems - 1);
+    }
+
+    /*
+     Inserts the specified data at the front of this deque.
+     */
+    void insertAtStart(T* data) {
+        if (this->numItems == this->capacity) {
+            this->grow(this->numItems + 1);
+        }
+        this->head = (this->head - 1) & (this->capacity - 1);
+        this->buffer[this->head] = data;
+        this->numItems++;
+    }
+
+    /*
+     Inserts the specified data at the back of this deque.
+     */
+    void insertAtEnd(T* data) {
+        if (this->numItems == this->capacity) {
+            this->grow(this->numItems + 1);
+        }
+        this->buffer[this->slot(this->numItems)] = data;
+        this->numItems++;
+    }
+
+    /*
+     Removes the element at the front of this deque and returns its data,
+     or returns the null pointer if the deque is empty.
+     */
+    T* removeFromStart() {
+        T* result = nullptr;
+        if (this->numItems > 0) {
+            result = this->buffer[this->head];
+            this->head = this->slot(1);
+            this->numItems--;
+        }
+        return result;
+    }
+
+    /*
+     Removes the element at the back of this deque and returns its data,
+     or returns the null pointer if the deque is empty.
+     */
+    T* removeFromEnd() {
+        T* result = nullptr;
+        if (this->numItems > 0) {
+            this->numItems--;
+            result = this->buffer[this->slot(this->numItems)];
+        }
+        return result;
+    }
+
+    /*
+     Removes every element from this deque, keeping its buffer. The data is
+     left alone.
+     */
+    void clear() {
+        this->head = 0;
+        this->numItems = 0;
+    }
+
+    /*
+     Returns an iterator positioned at the front of this deque.
+     */
+    Iterator begin() {
+        return Iterator(this, 0);
+    }
+
+    /*
+     Returns the past-the-end iterator of this deque.
+     */
+    Iterator end() {
+        return Iterator(this, this->numItems);
+    }
+
+    /*
+     Returns a string representation of this deque.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "Deque at " << this << std::endl;
+        if (this->numItems > 0) {
+            sout << "Deque contains " << this->numItems << " elements" << std::endl;
+            sout << "Capacity is " << this->capacity << std::endl;
+        }
+        else {
+            sout << "This deque is empty" << std::endl;
+        }
+        return sout.str();
+    }
+
+};
@@ -6,8 +6,17 @@
 #include "Pair.h"
 #include "Vertex.h"
 
-template <typename T, typename U>
-class Edge {
+/*
+ The part of a directed edge that doesn't depend on the type of its data:
+ its two vertices, its weight and its ID. Vertices keep their outgoing
+ edges as EdgeBase pointers, since a vertex doesn't know the edge data
+ type; every edge of a Graph<T, U> is an Edge<T, U>.
+ */
+template <typename T>
+class EdgeBase {
+
+    template <typename, typename>
+    friend class Graph;
 
 protected:
 
@@ -16,7 +25,7 @@ protected:
      member of the pair is the "from" vertex, and the second member is the
      "to" vertex
      */
-    Pair<Vertex<T>, Vertex<T>>* theEdge;
+    Pair<Vertex<T>, Vertex<T>> theEdge;
 
     /*
      The weight associated with this edge
@@ -24,19 +33,28 @@ protected:
     double edgeWeight;
 
     /*
-     The data stored in this edge
+     The ID of this edge in the graph that created it, or -1 if no graph
+     did. Set by the graph.
      */
-    U* data;
+    int id;
+
+    /*
+     Creates an edge with the specified initial and terminal vertices, and
+     weight 1.
+     */
+    EdgeBase(Vertex<T>* initialVertex, Vertex<T>* terminalVertex) : theEdge(initialVertex, terminalVertex) {
+        this->edgeWeight = 1;
+        this->id = -1;
+    }
 
 public:
 
     /*
-     Creates an edge with the specified initial and terminal vertices.
+     Returns the ID of this edge in the graph that created it, which is also
+     its index there, or a negative number if no graph created it.
      */
-    Edge(Vertex<T>* initialVertex, Vertex<T>* terminalVertex) {
-        this->theEdge = new Pair<Vertex<T>, Vertex<T>>(initialVertex, terminalVertex);
-        this->edgeWeight = 1;
-        this->data = nullptr;
+    int getId() {
+        return this->id;
     }
 
     /*
@@ -54,40 +72,68 @@ public:
     }
 
     /*
-     Returns a pointer to the data stored in this edge. If there is no data
-     stored in this edge, the null pointer is returned.
+     Returns the initial vertex for this edge.
      */
-    U* getData() {
-        return this->data;
+    Vertex<T>* getInitialVertex() {
+        return this->theEdge.first;
     }
 
     /*
-     Sets the data stored in this edge.
+     Returns the terminal vertex for this edge.
      */
-    void setData(U* data) {
-        this->data = data;
+    Vertex<T>* getTerminalVertex() {
+        return this->theEdge.second;
     }
 
     /*
-     Returns the initial vertex for this edge.
+     Returns true if and only if the initial and terminial vertices for this
+     edge are identical.
      */
-    Vertex<T>* getInitialVertex() {
-        return this->theEdge->first;
+    bool isLoop() {
+        return this->theEdge.first == this->theEdge.second;
     }
 
+};
+
+/*
+ A directed edge between two vertices, with a weight and optional data. An
+ edge does not own its vertices or its data, so copying an edge gives
+ another edge between the same vertices, sharing the same data. The
+ endpoints are stored in the edge itself, so creating one makes no other
+ allocation.
+ */
+template <typename T, typename U>
+class Edge : public EdgeBase<T> {
+
+protected:
+
     /*
-     Returns the terminal vertex for this edge.
+     The data stored in this edge
      */
-    Vertex<T>* getTerminalVertex() {
-        return this->theEdge->second;
+    U* data;
+
+public:
+
+    /*
+     Creates an edge with the specified initial and terminal vertices.
+     */
+    Edge(Vertex<T>* initialVertex, Vertex<T>* terminalVertex) : EdgeBase<T>(initialVertex, terminalVertex) {
+        this->data = nullptr;
     }
 
     /*
-     Returns true if and only if the initial and terminial vertices for this
-     edge are identical.
+     Returns a pointer to the data stored in this edge. If there is no data
+     stored in this edge, the null pointer is returned.
      */
-    bool isLoop() {
-        return this->theEdge->first == this->theEdge->second;
+    U* getData() {
+        return this->data;
+    }
+
+    /*
+     Sets the data stored in this edge.
+     */
+    void setData(U* data) {
+        this->data = data;
     }
 
     /*
@@ -96,8 +142,8 @@ public:
     std::string toString() {
         std::ostringstream sout;
         sout << "Edge at " << this << std::endl;
-        sout << " Initial vertex at " << this->theEdge->first << std::endl;
-        sout << " Terminal vertex as " << this->theEdge->second << std::endl;
+        sout << " Initial vertex at " << this->theEdge.first << std::endl;
+        sout << " Terminal vertex as " << this->theEdge.second << std::endl;
         sout << " Edge weight is " << this->edgeWeight << std::endl;
         if (this->data != nullptr) {
             sout << " Data at " << this->data << std::endl;
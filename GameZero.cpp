@@ -6,6 +6,7 @@
 
 GameZero::GameZero() {
 	this->thePlayer = new Player();
+	this->ownsPlayer = true;
 	// get player information 
 	this->getUserInfo();
 	// build the game graph
@@ -17,6 +18,7 @@ GameZero::GameZero() {
 
 GameZero::GameZero(Player* player) {
 	this->thePlayer = player;
+	this->ownsPlayer = false;
 	// build the game graph
 	this->buildGameGraph();
 	// output player info to screen
@@ -24,6 +26,13 @@ GameZero::GameZero(Player* player) {
 	std::cout << thePlayer->toString() << std::endl;
 }
 
+GameZero::~GameZero() {
+	delete this->theGraph;
+	if (this->ownsPlayer) {
+		delete this->thePlayer;
+	}
+}
+
 void GameZero::startGame() {
 	std::cout << "Welcome to DUNGEONS OF DOOM! Press the Return key to continue, or type 'exit' then Return to quit." << std::endl;
 	getUserResponse();
@@ -43,11 +52,9 @@ std::string GameZero::toString() {
 	sout << this->thePlayer->toString() << std::endl;
 	sout << "Story in the Dragon's Lair:" << std::endl;
 	// get a pointer to the list of strings stored in vertex 0
-	List<std::string>* storyList = this->theGraph->getVertexData(0);
-	for (int k = 0; k < storyList->getSize(); k++) {
-		// get item k from the list
-		std::string* itemK = storyList->peek(k);
-		sout << *itemK << std::endl;
+	ValueList<std::string>* storyList = this->theGraph->getVertexData(0);
+	for (std::string& itemK : *storyList) {
+		sout << itemK << std::endl;
 	}
 	return sout.str();
 }
@@ -98,22 +105,23 @@ std::string GameZero::getUserResponse() {
 
 
 void GameZero::buildGameGraph() {
-	this->theGraph = new Graph<List<std::string>, List<std::string>>();
+	// the graph owns the story lists stored in it
+	this->theGraph = new Graph<ValueList<std::string>, ValueList<std::string>>(DataOwnership::Owned);
 	// add a single vertex
-	Vertex<List<std::string>>* dragonsLair = new Vertex<List<std::string>>();
+	Vertex<ValueList<std::string>>* dragonsLair = new Vertex<ValueList<std::string>>();
 	this->theGraph->addVertex(dragonsLair);
 	// add some string data to describe the story that occurs in the dragons lair.
-	List<std::string>* storyList = new List<std::string>();
-	// add some strings to the list
-	storyList->insertAtEnd(new std::string("You awaken in a large underground hall."));
-	storyList->insertAtEnd(new std::string("Firelight flickers from torches mounted on the walls, illuminating vast treasures of gold, jewels, silks, and art."));
-	storyList->insertAtEnd(new std::string("On top of the largest pile of gold lies a sleeping green dragon."));
-	storyList->insertAtEnd(new std::string("Wisps of smoke curl lazily about her head as she snores."));
-	storyList->insertAtEnd(new std::string("She opens one eye lazily, but she's staring right at you!"));
-	storyList->insertAtEnd(new std::string("A low rumble quickly crescendos to a roar as she raises her head and spews out a stream of fire in your direction!!"));
-	storyList->insertAtEnd(new std::string("You withstand the initial blast, but the flames congeal into three ghost-like forms!!!"));
-	storyList->insertAtEnd(new std::string("Fire-ghosts! And they are attacking you!!!!"));
-	storyList->insertAtEnd(new std::string("Fight for your life!!!!!"));
+	ValueList<std::string>* storyList = new ValueList<std::string>({
+		"You awaken in a large underground hall.",
+		"Firelight flickers from torches mounted on the walls, illuminating vast treasures of gold, jewels, silks, and art.",
+		"On top of the largest pile of gold lies a sleeping green dragon.",
+		"Wisps of smoke curl lazily about her head as she snores.",
+		"She opens one eye lazily, but she's staring right at you!",
+		"A low rumble quickly crescendos to a roar as she raises her head and spews out a stream of fire in your direction!!",
+		"You withstand the initial blast, but the flames congeal into three ghost-like forms!!!",
+		"Fire-ghosts! And they are attacking you!!!!",
+		"Fight for your life!!!!!"
+	});
 
 	// store the list in the vertex of this graph
 	this->theGraph->storeInVertex(storyList, 0);
@@ -121,11 +129,10 @@ void GameZero::buildGameGraph() {
 
 
 void GameZero::printVertexData() {
-	List<std::string>* storyList = this->theGraph->getVertexData(0);
+	ValueList<std::string>* storyList = this->theGraph->getVertexData(0);
 	std::string userResponse;
-	for (int k = 0; k < storyList->getSize(); k++) {
-		std::string* lineK = storyList->peek(k);
-		std::cout << *lineK << std::endl;
+	for (std::string& lineK : *storyList) {
+		std::cout << lineK << std::endl;
 		userResponse = getUserResponse();
 	}
 }
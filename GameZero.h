@@ -4,6 +4,7 @@
 
 #include "Graph.h"
 #include "List.h"
+#include "ValueList.h"
 #include "Player.h"
 
 /*
@@ -33,6 +34,11 @@ public:
 	*/
 	GameZero(Player* player);
 
+	/*
+	Destroys the game graph, and the player if the game created it.
+	*/
+	~GameZero();
+
 	/*
 	Method to start the game.
 	*/
@@ -55,10 +61,15 @@ protected:
 	*/
 	Player* thePlayer;
 
+	/*
+	True if and only if the game created the player, and so must delete it.
+	*/
+	bool ownsPlayer;
+
 	/*
 	The graph for our RPG.
 	*/
-	Graph<List<std::string>, List<std::string>>* theGraph;
+	Graph<ValueList<std::string>, ValueList<std::string>>* theGraph;
 
 	/*
 	Function to prompt the game player for character information, and then create
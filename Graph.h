@@ -2,20 +2,35 @@
 
 #include <cmath>
 //#include <ctgmath>
+#include <cstddef>
+#include <iterator>
 #include <sstream>
 #include <string>
 #include <typeinfo>
+#include <utility>
+#include <vector>
 
-#include "Vertex.h"
 #include "Edge.h"
-
-// Note 1: when adding vertices or edges, use List::insertAtEnd. This
-//         makes the indices assigned to the vertex or edge are in the
-//         same order as the order in which the vertices or edges were
-//         added.
+#include "List.h"
+#include "Map.h"
+#include "Ownership.h"
+#include "Pair.h"
+#include "Queue.h"
+#include "Stack.h"
+#include "Vertex.h"
 
 /*
  A class to represent finite directed graphs.
+
+ A graph owns its vertices and edges: vertices added to it, and the edges
+ it creates, are deleted with the graph, so a vertex must not be added to
+ more than one graph. Whether the graph also owns the data stored in its
+ vertices and edges is set by the DataOwnership passed to the constructor.
+
+ Every vertex and edge gets an integer ID when it joins the graph: its
+ index, counting from 0 in the order they were added. IDs are dense and
+ never change, so algorithms can keep per-vertex or per-edge state in
+ plain arrays, and the methods taking an int index take IDs.
  */
 template <typename T, typename U>
 class Graph {
@@ -23,23 +38,299 @@ class Graph {
 protected:
 
     /*
-     List of vertices of this graph.
+     List of vertices of this graph, in the order they were added. It is
+     contiguous so that a vertex is reached from its ID, and checked for
+     membership, in O(1) time.
+     */
+    List<Vertex<T>, ContiguousStorage>* vertices;
+
+    /*
+     List of edges of this graph, in the order they were added. It is
+     contiguous so that reaching an edge by its index takes O(1) time.
+     */
+    List<Edge<T, U>, ContiguousStorage>* edges;
+
+    /*
+     The edges of this graph keyed by their (from, to) vertices, so that
+     finding the edge between two vertices takes O(1) expected time.
+     */
+    Map<Pair<Vertex<T>, Vertex<T>>, Edge<T, U>*> edgesByEndpoints;
+
+    /*
+     Whether this graph deletes the data stored in its vertices and edges.
      */
-    List<Vertex<T>>* vertices;
+    DataOwnership dataOwnership;
 
     /*
-     List of edges of this graph.
+     Creates the empty vertex and edge lists.
      */
-    List<Edge<T, U>>* edges;
+    void createLists() {
+        this->vertices = new List<Vertex<T>, ContiguousStorage>();
+        this->edges = new List<Edge<T, U>, ContiguousStorage>();
+    }
+
+    /*
+     Adds the specified vertex, which must not be in this graph yet, giving
+     it the next ID.
+     */
+    void insertVertex(Vertex<T>* vertex) {
+        vertex->id = this->vertices->getSize();
+        this->vertices->insertAtEnd(vertex);
+    }
+
+    /*
+     Returns the edge of this graph from the specified vertex to the other
+     specified vertex, or the null pointer if there is none.
+     */
+    Edge<T, U>* findEdge(Vertex<T>* from, Vertex<T>* to) {
+        Edge<T, U>** found = this->edgesByEndpoints.get(Pair<Vertex<T>, Vertex<T>>(from, to));
+        return found != nullptr ? *found : nullptr;
+    }
+
+    /*
+     Deletes the specified data if this graph owns it.
+     */
+    template <typename D>
+    void releaseData(D* data) {
+        if (this->dataOwnership == DataOwnership::Owned) {
+            delete data;
+        }
+    }
+
+    /*
+     Returns the data to store in a copy of a vertex or edge holding the
+     specified data: the same pointer if the data is borrowed, otherwise a
+     new copy of the data.
+     */
+    template <typename D>
+    D* copyData(D* data) {
+        D* result = data;
+        if (this->dataOwnership == DataOwnership::Owned && data != nullptr) {
+            result = new D(*data);
+        }
+        return result;
+    }
+
+    /*
+     Deletes every edge and vertex of this graph, and their data if this
+     graph owns it, then the vertex and edge lists themselves.
+     */
+    void destroy() {
+        for (Edge<T, U>* edgeK : *this->edges) {
+            this->releaseData(edgeK->getData());
+            delete edgeK;
+        }
+        // every neighbour is going too, so skip the per-vertex unlinking
+        for (Vertex<T>* vertexK : *this->vertices) {
+            vertexK->previousNodes.clear();
+            vertexK->nextNodes.clear();
+            vertexK->outEdges.clear();
+        }
+        for (Vertex<T>* vertexK : *this->vertices) {
+            this->releaseData(vertexK->getData());
+            delete vertexK;
+        }
+        delete this->vertices;
+        delete this->edges;
+    }
 
 public:
 
     /*
-     Creates an empty graph.
+     A read-only view of the vertices or the edges of a graph, in the order
+     they were added. It has the reading half of the List interface; only
+     the graph adds to the list it views, so that IDs, indices and lookups
+     stay in step.
+     */
+    template <typename E>
+    class ElementView {
+
+    protected:
+
+        List<E, ContiguousStorage>* elements;
+
+    public:
+
+        typedef typename List<E, ContiguousStorage>::Iterator Iterator;
+
+        ElementView(List<E, ContiguousStorage>* elements) {
+            this->elements = elements;
+        }
+
+        bool isEmpty() {
+            return this->elements->isEmpty();
+        }
+
+        int getSize() {
+            return this->elements->getSize();
+        }
+
+        E* peek(int position) {
+            return this->elements->peek(position);
+        }
+
+        /*
+         Returns the position of the specified element, which is its ID, or
+         a negative number if it is not in the viewed list. This takes O(1)
+         time.
+         */
+        int getIndex(E* element) {
+            int result = -1;
+            if (element != nullptr && element->getId() >= 0 && this->elements->peek(element->getId()) == element) {
+                result = element->getId();
+            }
+            return result;
+        }
+
+        Iterator begin() {
+            return this->elements->begin();
+        }
+
+        Iterator end() {
+            return this->elements->end();
+        }
+
+    };
+
+    typedef ElementView<Vertex<T>> VertexView;
+    typedef ElementView<Edge<T, U>> EdgeView;
+
+    /*
+     A forward iterator over the outgoing edges of a vertex, in the order
+     they were added. Each edge gives the neighbour it leads to
+     (getTerminalVertex), its weight and its data.
      */
-    Graph() {
-        this->vertices = new List<Vertex<T>>();
-        this->edges = new List<Edge<T, U>>();
+    class OutgoingEdgeIterator {
+
+    protected:
+
+        EdgeBase<T>** current;
+
+    public:
+
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Edge<T, U>* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Edge<T, U>** pointer;
+        typedef Edge<T, U>* reference;
+
+        OutgoingEdgeIterator(EdgeBase<T>** current) {
+            this->current = current;
+        }
+
+        Edge<T, U>* operator*() const {
+            // every edge a graph adds to its vertices is one of its own
+            return static_cast<Edge<T, U>*>(*this->current);
+        }
+
+        OutgoingEdgeIterator& operator++() {
+            this->current++;
+            return *this;
+        }
+
+        OutgoingEdgeIterator operator++(int) {
+            OutgoingEdgeIterator result = *this;
+            this->current++;
+            return result;
+        }
+
+        bool operator==(const OutgoingEdgeIterator& other) const {
+            return this->current == other.current;
+        }
+
+        bool operator!=(const OutgoingEdgeIterator& other) const {
+            return this->current != other.current;
+        }
+
+    };
+
+    /*
+     The outgoing edges of a vertex, for use in a range-based for loop. It
+     reads the vertex's own list, so it is invalidated by adding an edge
+     from that vertex.
+     */
+    class OutgoingEdgeRange {
+
+    protected:
+
+        OutgoingEdgeIterator first;
+        OutgoingEdgeIterator last;
+
+    public:
+
+        OutgoingEdgeRange(OutgoingEdgeIterator first, OutgoingEdgeIterator last) : first(first), last(last) {}
+
+        OutgoingEdgeIterator begin() {
+            return this->first;
+        }
+
+        OutgoingEdgeIterator end() {
+            return this->last;
+        }
+
+    };
+
+    /*
+     Creates an empty graph. By default the graph does not own the data
+     stored in its vertices and edges.
+     */
+    Graph(DataOwnership dataOwnership = DataOwnership::Borrowed) {
+        this->dataOwnership = dataOwnership;
+        this->createLists();
+    }
+
+    /*
+     Creates a graph with the same shape as the specified one: a new vertex
+     for each of its vertices and a new edge, with the same weight, for each
+     of its edges. Indices are preserved. Borrowed data is shared with the
+     specified graph; owned data is copied.
+     */
+    Graph(const Graph<T, U>& other) {
+        this->dataOwnership = other.dataOwnership;
+        this->createLists();
+        for (Vertex<T>* vertexK : *other.vertices) {
+            this->insertVertex(new Vertex<T>(this->copyData(vertexK->getData())));
+        }
+        for (Edge<T, U>* edgeK : *other.edges) {
+            Vertex<T>* from = this->getVertex(edgeK->getInitialVertex()->getId());
+            Vertex<T>* to = this->getVertex(edgeK->getTerminalVertex()->getId());
+            this->addEdge(from, to);
+            Edge<T, U>* newEdge = this->getEdge(this->getNumEdges() - 1);
+            newEdge->setWeight(edgeK->getWeight());
+            newEdge->setData(this->copyData(edgeK->getData()));
+        }
+    }
+
+    /*
+     Creates a graph that takes over the vertices and edges of the specified
+     one, leaving it empty.
+     */
+    Graph(Graph<T, U>&& other) {
+        this->dataOwnership = other.dataOwnership;
+        this->vertices = other.vertices;
+        this->edges = other.edges;
+        this->edgesByEndpoints.swap(other.edgesByEndpoints);
+        other.createLists();
+    }
+
+    /*
+     Replaces the contents of this graph with a copy of, or the contents of,
+     the specified graph.
+     */
+    Graph<T, U>& operator=(Graph<T, U> other) {
+        std::swap(this->vertices, other.vertices);
+        std::swap(this->edges, other.edges);
+        this->edgesByEndpoints.swap(other.edgesByEndpoints);
+        std::swap(this->dataOwnership, other.dataOwnership);
+        return *this;
+    }
+
+    /*
+     Deletes the vertices and edges of this graph, and their data if this
+     graph owns it.
+     */
+    ~Graph() {
+        this->destroy();
     }
 
     /*
@@ -57,11 +348,11 @@ public:
     }
 
     /*
-     Returns a pointer to a list containing pointers to all the vertices in
-     this graph.
+     Returns a read-only view of the vertices of this graph, in the order
+     they were added. Add vertices with addVertex or addEdge.
      */
-    List<Vertex<T>>* getVertices() {
-        return this->vertices;
+    VertexView getVertices() {
+        return VertexView(this->vertices);
     }
 
     /*
@@ -72,11 +363,11 @@ public:
     }
 
     /*
-     Returns a pointer to a list containing pointers to all the edges in this
-     graph.
+     Returns a read-only view of the edges of this graph, in the order they
+     were added. Add edges with addEdge.
      */
-    List<Edge<T, U>>* getEdges() {
-        return this->edges;
+    EdgeView getEdges() {
+        return EdgeView(this->edges);
     }
 
     /*
@@ -85,8 +376,7 @@ public:
      */
     int getInDegree(Vertex<T>* vertex) {
         int inDegree;
-        int ndx = this->vertices->getIndex(vertex);
-        if (ndx < 0) {
+        if (!this->hasVertex(vertex)) {
             inDegree = -1;
         }
         else {
@@ -95,14 +385,22 @@ public:
         return inDegree;
     }
 
+    /*
+     Returns the in-degree of the vertex with the specified ID, or a
+     negative number if no vertex of this graph has that ID.
+     */
+    int getInDegree(int id) {
+        Vertex<T>* vertex = this->getVertex(id);
+        return vertex != nullptr ? vertex->getInDegree() : -1;
+    }
+
     /*
      Returns the out-degree of the specified vertex, or a negative
      number if the specified vertex does not belong to this graph.
      */
     int getOutDegree(Vertex<T>* vertex) {
         int outDegree;
-        int ndx = this->vertices->getIndex(vertex);
-        if (ndx < 0) {
+        if (!this->hasVertex(vertex)) {
             outDegree = -1;
         }
         else {
@@ -112,42 +410,55 @@ public:
     }
 
     /*
-     Returns the vertex with the given index. If no vertex has the given
-     index, this method returns the null pointer.
+     Returns the out-degree of the vertex with the specified ID, or a
+     negative number if no vertex of this graph has that ID.
+     */
+    int getOutDegree(int id) {
+        Vertex<T>* vertex = this->getVertex(id);
+        return vertex != nullptr ? vertex->getOutDegree() : -1;
+    }
+
+    /*
+     Returns the vertex with the given index (its ID). If no vertex has the
+     given index, this method returns the null pointer. This takes O(1)
+     time.
      */
     Vertex<T>* getVertex(int index) {
         return this->vertices->peek(index);
     }
 
     /*
-     Adds the specified vertex to this graph. Vertices can't be added twice,
-     so if the specified vertex is already part of this graph, this method
-     does nothing.
+     Adds the specified vertex to this graph, which takes ownership of it.
+     Vertices can't be added twice, so if the specified vertex is already
+     part of this graph, or is the null pointer, this method does nothing.
      TODO: give this an int return type to flag whether the add was successful.
      */
     void addVertex(Vertex<T>* vertex) {
-        int ndx = this->vertices->getIndex(vertex);
-        // if the specified vertex is already in the graph, do nothing,
-        // otherwise insert the new vertex at the end of the vertex list
-        if (ndx < 0) {
-            this->vertices->insertAtEnd(vertex);
+        // if the specified vertex is null or already in the graph, do
+        // nothing, otherwise insert the new vertex at the end of the
+        // vertex list
+        if (vertex != nullptr && !this->hasVertex(vertex)) {
+            this->insertVertex(vertex);
         }
     }
 
     /*
      Returns true if and only the specified vertex is
-     part of this graph.
+     part of this graph. This takes O(1) time: the vertex is a member if
+     the vertex with its ID is the vertex itself.
      */
     bool hasVertex(Vertex<T>* vertex) {
-        return this->vertices->getIndex(vertex) >= 0;
+        return this->getVertices().getIndex(vertex) >= 0;
     }
 
     /*
-     Returns the edge in this graph with the given indices, or the null pointer
-     if no edge with the given index exists in this graph.
-     TODO: add to spec, implement
+     Returns the edge in this graph with the given index, or the null pointer
+     if no edge with the given index exists in this graph. Edges are indexed
+     in the order they were added, and this takes O(1) time.
      */
-    Edge<T, U>* getEdge(int index);
+    Edge<T, U>* getEdge(int index) {
+        return this->edges->peek(index);
+    }
 
     /*
      Adds an unidirectional edge to the Graph, from the first argument to
@@ -155,64 +466,45 @@ public:
      already exists in this graph between the from and to vertices, this
      method does nothing. If either of the two input vertices are not already
      part of this Graph, they are added. If the from and to vertices are
-     actually the same vertex, a loop is added to that vertex.
+     actually the same vertex, a loop is added to that vertex. If either
+     vertex is the null pointer, this method does nothing.
      TODO: give this an int return type to flag if the add was successful
      */
     void addEdge(Vertex<T>* from, Vertex<T>* to) {
-        // see if this edge is alread in the graph
-
-        int edgeNdx = -1;
-        for (int k = 0; k < this->edges->getSize(); k++) {
-            Edge<T, U>* edgeK = this->edges->peek(k);
-            if (edgeK->getInitialVertex() == from && edgeK->getTerminalVertex() == to) {
-                edgeNdx = k;
-                break;
+        // if either vertex is null or this edge is already in the graph, do
+        // nothing. Otherwise:
+        if (from != nullptr && to != nullptr && this->findEdge(from, to) == nullptr) {
+            // if either vertex is not in the graph, add it. A loop adds its
+            // vertex once.
+            if (!this->hasVertex(from)) {
+                this->insertVertex(from);
+            }
+            if (!this->hasVertex(to)) {
+                this->insertVertex(to);
             }
+            // add the new edge to this graph, to the index by vertices and
+            // to the outgoing edges of its from vertex
+            Edge<T, U>* newEdge = new Edge<T, U>(from, to);
+            newEdge->id = this->edges->getSize();
+            this->edges->insertAtEnd(newEdge);
+            this->edgesByEndpoints.put(Pair<Vertex<T>, Vertex<T>>(from, to), newEdge);
+            from->outEdges.insertAtEnd(newEdge);
+            // manage previousNodes and nextNodes. For a loop, the vertex is
+            // both an incoming and outgoing vertex of itself.
+            from->addOutVertex(to);
         }
+    }
 
-        // if this edge is already in the graph, do nothing. Otherwise:
-        if (edgeNdx < 0) {
-            Edge<T, U>* newEdge = new Edge<T, U>(from, to);
-            // need to handle a special case: if the from and to vertices
-            // are actually the same, then we're adding a edge from that
-            // vertex to itself. Otherwise, we're adding an edge between
-            // different vertices
-            if (from == to) {
-                // get the indices for the from node (which is the same as
-                // the to node). If getIndex returns a negative number, it
-                // means that the corresponding vertex is not a member of
-                // this graph.
-                int fromNdx = this->vertices->getIndex(from);
-                // if the vertex is not in the graph, add it
-                if (fromNdx < 0) {
-                    this->vertices->insertAtEnd(from);
-                }
-                // add the new edge to this graph
-                this->edges->insertAtEnd(newEdge);
-                // manage previousNodes and nextNodes. Since the edge goes
-                // from a vertex to itself, the vertex is both an incoming
-                // and outgoing vertex of itself.
-                from->addOutVertex(from);
-            }
-            else {
-                // get the indices for the from and to nodes. If getIndex returns
-                // a negative number, it means that the corresponding vertex is
-                // not a member of this graph.
-                int fromNdx = this->vertices->getIndex(from);
-                int toNdx = this->vertices->getIndex(to);
-                // if the from vertex is not in the graph, add it
-                if (fromNdx < 0) {
-                    this->vertices->insertAtEnd(from);
-                }
-                // if the to vertex is not in the graph, add it
-                if (toNdx < 0) {
-                    this->vertices->insertAtEnd(to);
-                }
-                // add the new edge to this graph
-                this->edges->insertAtEnd(newEdge);
-                // manage previousNodes and nextNodes
-                from->addOutVertex(to);
-            }
+    /*
+     Adds an edge from the vertex with the first ID to the vertex with the
+     second, as addEdge does with vertices. If either ID is not the ID of a
+     vertex of this graph, this method does nothing.
+     */
+    void addEdge(int fromId, int toId) {
+        Vertex<T>* from = this->getVertex(fromId);
+        Vertex<T>* to = this->getVertex(toId);
+        if (from != nullptr && to != nullptr) {
+            this->addEdge(from, to);
         }
     }
 
@@ -221,20 +513,21 @@ public:
      part of this graph.
      */
     bool hasEdge(Vertex<T>* from, Vertex<T>* to) {
-        bool result = false;
-        for (int k = 0; k < this->getNumEdges(); k++) {
-            Edge<T, U>* edgeK = this->edges->peek(k);
-            if (edgeK->getInitialVertex() == from && edgeK->getTerminalVertex() == to) {
-                result = true;
-            }
-        }
-        return result;
+        return this->findEdge(from, to) != nullptr;
+    }
+
+    /*
+     Returns true if and only if this graph has an edge from the vertex with
+     the first ID to the vertex with the second.
+     */
+    bool hasEdge(int fromId, int toId) {
+        return this->hasEdge(this->getVertex(fromId), this->getVertex(toId));
     }
 
     /*
      Returns a list of the outgoing vertices from the specified vertex.
      If the specified vertex is not part of this graph, an empty list
-     is returned.
+     is returned. The caller owns the returned list, and must delete it.
      */
     List<Vertex<T>>* getOutgoingVertices(Vertex<T>* vertex) {
         List<Vertex<T>>* result = new List<Vertex<T>>();
@@ -247,10 +540,63 @@ public:
         return result;
     }
 
+    /*
+     Returns the outgoing edges from the specified vertex, in the order they
+     were added, without searching this graph's edge list:
+
+        for (Edge<T, U>* edge : graph.getOutgoingEdgeRange(vertex)) {
+            // edge->getTerminalVertex(), edge->getWeight(), edge->getData()
+        }
+
+     If the specified vertex is not part of this graph, the range is empty.
+     */
+    OutgoingEdgeRange getOutgoingEdgeRange(Vertex<T>* vertex) {
+        if (!this->hasVertex(vertex)) {
+            return OutgoingEdgeRange(nullptr, nullptr);
+        }
+        return OutgoingEdgeRange(vertex->outEdges.begin(), vertex->outEdges.end());
+    }
+
+    /*
+     Returns the outgoing edges from the vertex with the specified ID. If no
+     vertex of this graph has that ID, the range is empty.
+     */
+    OutgoingEdgeRange getOutgoingEdgeRange(int id) {
+        return this->getOutgoingEdgeRange(this->getVertex(id));
+    }
+
+    /*
+     Returns the outgoing edge from the specified vertex with the specified
+     index, counting in the order the edges were added. If the vertex is not
+     part of this graph, or has no outgoing edge with that index, this
+     method returns the null pointer.
+     */
+    Edge<T, U>* getOutgoingEdge(Vertex<T>* vertex, int index) {
+        Edge<T, U>* result = nullptr;
+        if (this->hasVertex(vertex)) {
+            result = static_cast<Edge<T, U>*>(vertex->outEdges.peek(index));
+        }
+        return result;
+    }
+
+    /*
+     Returns a list of the outgoing edges from the specified vertex. If the
+     specified vertex is not part of this graph, an empty list is returned.
+     The caller owns the returned list, and must delete it.
+     */
+    List<Edge<T, U>>* getOutgoingEdges(Vertex<T>* vertex) {
+        List<Edge<T, U>>* result = new List<Edge<T, U>>();
+        for (Edge<T, U>* edge : this->getOutgoingEdgeRange(vertex)) {
+            result->insertAtEnd(edge);
+        }
+        return result;
+    }
+
     /*
      Returns a list of the incoming vertices to the specified vertex.
      If the specified vertex is not part of this graph, an empty list
-     is returned.xx     */
+     is returned. The caller owns the returned list, and must delete it.
+     */
     List<Vertex<T>>* getIncomingVertices(Vertex<T>* vertex) {
         List<Vertex<T>>* result = new List<Vertex<T>>();
         if (this->hasVertex(vertex)) {
@@ -262,17 +608,80 @@ public:
         return result;
     }
 
+    /*
+     Returns a list of the vertices reachable from the specified vertex, in
+     breadth-first order starting with the vertex itself. Outgoing vertices
+     are visited in index order, and vertices linked to outside this graph
+     are skipped. If the specified vertex is not part of this graph, an
+     empty list is returned. The caller owns the returned list, and must
+     delete it.
+     */
+    List<Vertex<T>>* getBreadthFirstOrder(Vertex<T>* start) {
+        List<Vertex<T>>* result = new List<Vertex<T>>();
+        if (this->hasVertex(start)) {
+            // visited vertices, by ID
+            std::vector<bool> visited(this->getNumVertices());
+            Queue<Vertex<T>> frontier;
+            visited[start->getId()] = true;
+            frontier.enqueue(start);
+            while (!frontier.isEmpty()) {
+                Vertex<T>* vertex = frontier.dequeue();
+                result->insertAtEnd(vertex);
+                int outDegree = vertex->getOutDegree();
+                for (int k = 0; k < outDegree; k++) {
+                    Vertex<T>* outVertex = vertex->getOutVertex(k);
+                    if (this->hasVertex(outVertex) && !visited[outVertex->getId()]) {
+                        visited[outVertex->getId()] = true;
+                        frontier.enqueue(outVertex);
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    /*
+     Returns a list of the vertices reachable from the specified vertex, in
+     depth-first preorder starting with the vertex itself. Outgoing vertices
+     are explored in index order, and vertices linked to outside this graph
+     are skipped. If the specified vertex is not part of this graph, an
+     empty list is returned. The caller owns the returned list, and must
+     delete it.
+     */
+    List<Vertex<T>>* getDepthFirstOrder(Vertex<T>* start) {
+        List<Vertex<T>>* result = new List<Vertex<T>>();
+        if (this->hasVertex(start)) {
+            // visited vertices, by ID
+            std::vector<bool> visited(this->getNumVertices());
+            Stack<Vertex<T>> pending;
+            pending.push(start);
+            while (!pending.isEmpty()) {
+                Vertex<T>* vertex = pending.pop();
+                if (!visited[vertex->getId()]) {
+                    visited[vertex->getId()] = true;
+                    result->insertAtEnd(vertex);
+                    // push in reverse so the lowest index is explored first
+                    for (int k = vertex->getOutDegree() - 1; k >= 0; k--) {
+                        Vertex<T>* outVertex = vertex->getOutVertex(k);
+                        if (this->hasVertex(outVertex) && !visited[outVertex->getId()]) {
+                            pending.push(outVertex);
+                        }
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
     /*
      Returns the weight of the specified edge. If the specified edge is not
      part of this graph, this method returns NaN (not a number) as a double.
      */
     double getEdgeWeight(Vertex<T>* from, Vertex<T>* to) {
         double result = std::nan("");
-        for (int k = 0; k < this->getNumEdges(); k++) {
-            Edge<T, U>* edgeK = this->edges->peek(k);
-            if (edgeK->getInitialVertex() == from && edgeK->getTerminalVertex() == to) {
-                result = edgeK->getWeight();
-            }
+        Edge<T, U>* theEdge = this->findEdge(from, to);
+        if (theEdge != nullptr) {
+            result = theEdge->getWeight();
         }
         return result;
     }
@@ -284,13 +693,22 @@ public:
     */
     double getEdgeWeight(int index) {
         double result = std::nan("");
-        Edge<T, U>* theEdge = this->edges->peek(index);
+        Edge<T, U>* theEdge = this->getEdge(index);
         if (theEdge != nullptr) {
             result = theEdge->getWeight();
         }
         return result;
     }
 
+    /*
+     Returns the weight of the edge from the vertex with the first ID to the
+     vertex with the second. If there is no such edge, this method returns
+     NaN (not a number) as a double.
+     */
+    double getEdgeWeight(int fromId, int toId) {
+        return this->getEdgeWeight(this->getVertex(fromId), this->getVertex(toId));
+    }
+
     /*
      Sets the weight of the specified edge. If the specified edge is not
      part of this graph, this method does nothing. If the set operation was
@@ -299,12 +717,10 @@ public:
     */
     int setEdgeWeight(double weight, Vertex<T>* from, Vertex<T>* to) {
         int result = -1;
-        for (int k = 0; k < this->getNumEdges(); k++) {
-            Edge<T, U>* edgeK = this->edges->peek(k);
-            if (edgeK->getInitialVertex() == from && edgeK->getTerminalVertex() == to) {
-                edgeK->setWeight(weight);
-                result = 0;
-            }
+        Edge<T, U>* theEdge = this->findEdge(from, to);
+        if (theEdge != nullptr) {
+            theEdge->setWeight(weight);
+            result = 0;
         }
         return result;
     }
@@ -317,7 +733,7 @@ public:
     */
     int setEdgeWeight(double weight, int index) {
         int result = -1;
-        Edge<T, U>* theEdge = this->edges->peek(index);
+        Edge<T, U>* theEdge = this->getEdge(index);
         if (theEdge != nullptr) {
             theEdge->setWeight(weight);
             result = 0;
@@ -325,6 +741,15 @@ public:
         return result;
     }
 
+    /*
+     Sets the weight of the edge from the vertex with the first ID to the
+     vertex with the second. Returns 0 on success, or a negative number if
+     there is no such edge.
+     */
+    int setEdgeWeight(double weight, int fromId, int toId) {
+        return this->setEdgeWeight(weight, this->getVertex(fromId), this->getVertex(toId));
+    }
+
     /*
      Stores the specified data in the specified vertex of this graph. If the
      specified vertex is not in this graph, then this method does nothing. If
@@ -334,6 +759,9 @@ public:
     int storeInVertex(T* data, Vertex<T>* vertex) {
         int result = -1;
         if (this->hasVertex(vertex)) {
+            if (vertex->getData() != data) {
+                this->releaseData(vertex->getData());
+            }
             vertex->setData(data);
             result = 0;
         }
@@ -348,8 +776,11 @@ public:
      */
     int storeInVertex(T* data, int index) {
         int result = -1;
-        Vertex<T>* v = this->vertices->peek(index);
+        Vertex<T>* v = this->getVertex(index);
         if (v != nullptr) {
+            if (v->getData() != data) {
+                this->releaseData(v->getData());
+            }
             v->setData(data);
             result = 0;
         }
@@ -377,7 +808,7 @@ public:
      */
     T* getVertexData(int index) {
         T* result = nullptr;
-        Vertex<T>* v = this->vertices->peek(index);
+        Vertex<T>* v = this->getVertex(index);
         if (v != nullptr) {
             result = v->getData();
         }
@@ -392,12 +823,13 @@ public:
      */
     int storeInEdge(U* data, Vertex<T>* from, Vertex<T>* to) {
         int result = -1;
-        for (int k = 0; k < this->getNumEdges(); k++) {
-            Edge<T, U>* edgeK = this->edges->peek(k);
-            if (edgeK->getInitialVertex() == from && edgeK->getTerminalVertex() == to) {
-                edgeK->setData(data);
-                result = 0;
+        Edge<T, U>* theEdge = this->findEdge(from, to);
+        if (theEdge != nullptr) {
+            if (theEdge->getData() != data) {
+                this->releaseData(theEdge->getData());
             }
+            theEdge->setData(data);
+            result = 0;
         }
         return result;
     }
@@ -410,14 +842,26 @@ public:
      */
     int storeInEdge(U* data, int index) {
         int result = -1;
-        Edge<T, U>* theEdge = this->edges->peek(index);
+        Edge<T, U>* theEdge = this->getEdge(index);
         if (theEdge != nullptr) {
+            if (theEdge->getData() != data) {
+                this->releaseData(theEdge->getData());
+            }
             theEdge->setData(data);
             result = 0;
         }
         return result;
     }
 
+    /*
+     Stores the specified data in the edge from the vertex with the first ID
+     to the vertex with the second. Returns 0 on success, or a negative
+     number if there is no such edge.
+     */
+    int storeInEdge(U* data, int fromId, int toId) {
+        return this->storeInEdge(data, this->getVertex(fromId), this->getVertex(toId));
+    }
+
     /*
      Retrieves a pointer to the data that is stored in the specified edge.
      If the specified edge is not part of this graph, or if there is no data
@@ -425,11 +869,9 @@ public:
      */
     U* getEdgeData(Vertex<T>* from, Vertex<T>* to) {
         U* result = nullptr;
-        for (int k = 0; k < this->getNumEdges(); k++) {
-            Edge<T, U>* edgeK = this->edges->peek(k);
-            if (edgeK->getInitialVertex() == from && edgeK->getTerminalVertex() == to) {
-                result = edgeK->getData();
-            }
+        Edge<T, U>* theEdge = this->findEdge(from, to);
+        if (theEdge != nullptr) {
+            result = theEdge->getData();
         }
         return result;
     }
@@ -442,7 +884,7 @@ public:
      */
     U* getEdgeData(int index) {
         U* result = nullptr;
-        Edge<T, U>* theEdge = this->edges->peek(index);
+        Edge<T, U>* theEdge = this->getEdge(index);
         if (theEdge != nullptr) {
             result = theEdge->getData();
         }
@@ -450,19 +892,30 @@ public:
     }
 
     /*
-     Returns the index of the specified vertex in this graph. If the specified
-     vertex is not part of this graph, this method returns a negative number.
+     Retrieves a pointer to the data stored in the edge from the vertex with
+     the first ID to the vertex with the second. If there is no such edge,
+     or no data stored in it, this method returns the null pointer.
+     */
+    U* getEdgeData(int fromId, int toId) {
+        return this->getEdgeData(this->getVertex(fromId), this->getVertex(toId));
+    }
+
+    /*
+     Returns the index (the ID) of the specified vertex in this graph. If the
+     specified vertex is not part of this graph, this method returns a
+     negative number.
      */
     int getVertexIndex(Vertex<T>* vertex) {
-        return this->vertices->getIndex(vertex);
+        return this->getVertices().getIndex(vertex);
     }
 
     /*
-     Returns the index of the specified edge in this graph. If the specified
-     edge is not part of this graph, this method returns a negative number.
+     Returns the index (the ID) of the specified edge in this graph. If the
+     specified edge is not part of this graph, this method returns a
+     negative number.
      */
     int getEdgeIndex(Edge<T, U>* edge) {
-        return this->edges->getIndex(edge);
+        return this->getEdges().getIndex(edge);
     }
 
     /*
@@ -2,9 +2,11 @@
 
 #include <cmath>
 #include <iostream>
+#include <map>
 #include <random>
 #include <sstream>
 #include <string>
+#include <utility>
 
 #include "Edge.h"
 #include "Graph.h"
@@ -13,6 +15,22 @@
 
 class GraphTester {
 
+protected:
+
+    /*
+     Data type for the ownership tests: counts live instances.
+     */
+    struct Counted {
+        static int& numLive() {
+            static int count = 0;
+            return count;
+        }
+        int value;
+        Counted(int value) : value(value) { numLive()++; }
+        Counted(const Counted& other) : value(other.value) { numLive()++; }
+        ~Counted() { numLive()--; }
+    };
+
 public:
 
     /*
@@ -612,8 +630,8 @@ public:
         }
         // test getEdges
         pointsPossible++;
-        List<Edge<int, int>>* theEdges = g->getEdges();
-        if (theEdges->peek(0)->getInitialVertex() == v && theEdges->peek(0)->getTerminalVertex() == v) {
+        Graph<int, int>::EdgeView theEdges = g->getEdges();
+        if (theEdges.peek(0)->getInitialVertex() == v && theEdges.peek(0)->getTerminalVertex() == v) {
             pointsEarned++;
         }
         else {
@@ -832,10 +850,10 @@ public:
             }
         }
         // check that indices are assigned to edges correctly
-        List<Edge<std::string, int>>* edges = g->getEdges();
+        Graph<std::string, int>::EdgeView edges = g->getEdges();
         for (int k = 0; k < 8; k++) {
             pointsPossible++;
-            Edge<std::string, int>* edgeK = edges->peek(k);
+            Edge<std::string, int>* edgeK = edges.peek(k);
             if (edgeK->getWeight() == k) {
                 pointsEarned++;
             }
@@ -1210,6 +1228,530 @@ public:
         return new TestResults(pointsPossible, pointsEarned, sout.str());
     }
 
+    /*
+     test destruction, copying and moving of graphs that own their data, and
+     the destruction of single vertices
+     */
+    static TestResults* test14() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        int liveBefore = Counted::numLive();
+        long vertexNodesBefore = NodePool<Node<Vertex<Counted>>>::getInstance().getNumInUse();
+        // a path on 10 vertices, with a loop on every vertex
+        Graph<Counted, Counted>* g = new Graph<Counted, Counted>(DataOwnership::Owned);
+        Vertex<Counted>** vertices = new Vertex<Counted>*[10];
+        for (int k = 0; k < 10; k++) {
+            vertices[k] = new Vertex<Counted>(new Counted(k));
+            g->addVertex(vertices[k]);
+        }
+        for (int k = 0; k < 10; k++) {
+            g->addEdge(vertices[k], vertices[k]);
+            if (k > 0) {
+                g->addEdge(vertices[k - 1], vertices[k]);
+            }
+        }
+        for (int k = 0; k < g->getNumEdges(); k++) {
+            g->storeInEdge(new Counted(k), k);
+            g->setEdgeWeight(k, k);
+        }
+        // replacing owned data deletes the old data
+        pointsPossible++;
+        g->storeInVertex(new Counted(100), 0);
+        if (Counted::numLive() == liveBefore + 29 && g->getVertexData(0)->value == 100) {
+            pointsEarned++;
+        }
+        else {
+            sout << "storeInVertex did not delete the data it replaced" << std::endl;
+        }
+        // copying gives the same shape with copies of the data
+        pointsPossible++;
+        Graph<Counted, Counted>* copy = new Graph<Counted, Counted>(*g);
+        bool correct = copy->getNumVertices() == 10 && copy->getNumEdges() == 19;
+        correct = correct && Counted::numLive() == liveBefore + 58;
+        for (int k = 0; k < 10 && correct; k++) {
+            correct = copy->getVertex(k) != g->getVertex(k);
+            correct = correct && copy->getVertexData(k) != g->getVertexData(k);
+            correct = correct && copy->getVertexData(k)->value == g->getVertexData(k)->value;
+            correct = correct && copy->hasEdge(copy->getVertex(k), copy->getVertex(k));
+        }
+        for (int k = 0; k < 19 && correct; k++) {
+            correct = copy->getEdgeWeight(k) == k && copy->getEdgeData(k)->value == k;
+        }
+        if (correct) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the copy constructor did not copy the graph correctly" << std::endl;
+        }
+        // moving takes over the vertices and edges
+        pointsPossible++;
+        Graph<Counted, Counted>* moved = new Graph<Counted, Counted>(std::move(*copy));
+        if (copy->isEmpty() && copy->getNumEdges() == 0 && moved->getNumVertices() == 10 && moved->getNumEdges() == 19) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the move constructor did not move the graph" << std::endl;
+        }
+        // deleting the graphs deletes their vertices, edges and data
+        pointsPossible++;
+        delete copy;
+        delete moved;
+        delete g;
+        long vertexNodesAfter = NodePool<Node<Vertex<Counted>>>::getInstance().getNumInUse();
+        if (Counted::numLive() == liveBefore && vertexNodesAfter == vertexNodesBefore) {
+            pointsEarned++;
+        }
+        else {
+            sout << "deleting the graphs left " << Counted::numLive() - liveBefore << " data items and "
+                << vertexNodesAfter - vertexNodesBefore << " adjacency nodes behind" << std::endl;
+        }
+        // a deleted vertex removes itself from its neighbours
+        pointsPossible++;
+        Vertex<int>* v0 = new Vertex<int>();
+        Vertex<int>* v1 = new Vertex<int>();
+        v0->addOutVertex(v1);
+        v1->addOutVertex(v0);
+        delete v1;
+        if (v0->getOutDegree() == 0 && v0->getInDegree() == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a deleted vertex was left in the adjacency lists of its neighbour" << std::endl;
+        }
+        delete v0;
+        delete[] vertices;
+        std::cout << "GraphTester::test14 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     test getBreadthFirstOrder and getDepthFirstOrder on a small tree with a
+     back edge and an unreachable vertex
+     */
+    static TestResults* test15() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        // 0 -> 1, 0 -> 2, 1 -> 3, 2 -> 4, 4 -> 0; vertex 5 is unreachable
+        Graph<int, int>* g = new Graph<int, int>();
+        Vertex<int>** vertices = new Vertex<int>*[6];
+        for (int k = 0; k < 6; k++) {
+            vertices[k] = new Vertex<int>();
+            g->addVertex(vertices[k]);
+        }
+        g->addEdge(vertices[0], vertices[1]);
+        g->addEdge(vertices[0], vertices[2]);
+        g->addEdge(vertices[1], vertices[3]);
+        g->addEdge(vertices[2], vertices[4]);
+        g->addEdge(vertices[4], vertices[0]);
+        pointsPossible++;
+        int expectedBreadthFirst[5] = { 0, 1, 2, 3, 4 };
+        List<Vertex<int>>* order = g->getBreadthFirstOrder(vertices[0]);
+        bool correct = order->getSize() == 5;
+        for (int k = 0; k < 5 && correct; k++) {
+            correct = order->peek(k) == vertices[expectedBreadthFirst[k]];
+        }
+        delete order;
+        if (correct) {
+            pointsEarned++;
+        }
+        else {
+            sout << "getBreadthFirstOrder returned the wrong order" << std::endl;
+        }
+        pointsPossible++;
+        int expectedDepthFirst[5] = { 0, 1, 3, 2, 4 };
+        order = g->getDepthFirstOrder(vertices[0]);
+        correct = order->getSize() == 5;
+        for (int k = 0; k < 5 && correct; k++) {
+            correct = order->peek(k) == vertices[expectedDepthFirst[k]];
+        }
+        delete order;
+        if (correct) {
+            pointsEarned++;
+        }
+        else {
+            sout << "getDepthFirstOrder returned the wrong order" << std::endl;
+        }
+        pointsPossible++;
+        List<Vertex<int>>* fromIsolated = g->getBreadthFirstOrder(vertices[5]);
+        Vertex<int>* outsider = new Vertex<int>();
+        List<Vertex<int>>* fromOutsider = g->getDepthFirstOrder(outsider);
+        if (fromIsolated->getSize() == 1 && fromOutsider->isEmpty()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "traversals from an isolated or foreign vertex were wrong" << std::endl;
+        }
+        delete fromIsolated;
+        delete fromOutsider;
+        delete outsider;
+        delete g;
+        delete[] vertices;
+        std::cout << "GraphTester::test15 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     test the edge lookups by vertices on a graph with many edges and
+     repeated addEdge calls, against a model, and after copying and moving
+     the graph
+     */
+    static TestResults* test16() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        int numVertices = 300;
+        Graph<int, int>* g = new Graph<int, int>();
+        Vertex<int>** vertices = new Vertex<int>*[numVertices];
+        for (int k = 0; k < numVertices; k++) {
+            vertices[k] = new Vertex<int>();
+            g->addVertex(vertices[k]);
+        }
+        std::map<std::pair<int, int>, int> model;
+        int* values = new int[20000];
+        std::mt19937 generator(16);
+        std::uniform_int_distribution<int> pick(0, numVertices - 1);
+        for (int k = 0; k < 20000; k++) {
+            int from = pick(generator);
+            int to = pick(generator);
+            values[k] = k;
+            g->addEdge(vertices[from], vertices[to]);
+            g->setEdgeWeight(k, vertices[from], vertices[to]);
+            g->storeInEdge(&values[k], vertices[from], vertices[to]);
+            model[std::make_pair(from, to)] = k;
+        }
+        // duplicates are ignored, and every lookup finds the latest update
+        pointsPossible++;
+        int numMismatches = 0;
+        for (int k = 0; k < 5000; k++) {
+            int from = pick(generator);
+            int to = pick(generator);
+            std::map<std::pair<int, int>, int>::iterator it = model.find(std::make_pair(from, to));
+            if (it == model.end()) {
+                bool missing = !g->hasEdge(vertices[from], vertices[to]) && std::isnan(g->getEdgeWeight(vertices[from], vertices[to]));
+                missing = missing && g->getEdgeData(vertices[from], vertices[to]) == nullptr;
+                if (!missing || g->setEdgeWeight(1, vertices[from], vertices[to]) >= 0 || g->storeInEdge(values, vertices[from], vertices[to]) >= 0) {
+                    numMismatches++;
+                }
+            }
+            else if (!g->hasEdge(vertices[from], vertices[to]) || g->getEdgeWeight(vertices[from], vertices[to]) != it->second
+                || g->getEdgeData(vertices[from], vertices[to]) != &values[it->second]) {
+                numMismatches++;
+            }
+        }
+        if (numMismatches == 0 && g->getNumEdges() == static_cast<int>(model.size())) {
+            pointsEarned++;
+        }
+        else {
+            sout << "edge lookups disagreed with the model " << numMismatches << " times" << std::endl;
+        }
+        // copies and moved-to graphs find their own edges
+        pointsPossible++;
+        Graph<int, int> copy(*g);
+        Graph<int, int> moved(std::move(*g));
+        std::pair<int, int> someEdge = model.begin()->first;
+        Vertex<int>* copyFrom = copy.getVertex(someEdge.first);
+        Vertex<int>* copyTo = copy.getVertex(someEdge.second);
+        bool correct = copy.hasEdge(copyFrom, copyTo) && !copy.hasEdge(vertices[someEdge.first], vertices[someEdge.second]);
+        correct = correct && moved.hasEdge(vertices[someEdge.first], vertices[someEdge.second]);
+        correct = correct && !g->hasEdge(vertices[someEdge.first], vertices[someEdge.second]) && g->getNumEdges() == 0;
+        if (correct && copy.getEdgeWeight(copyFrom, copyTo) == model.begin()->second) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a copied or moved graph lost its edge lookups" << std::endl;
+        }
+        delete g;
+        delete[] vertices;
+        delete[] values;
+        std::cout << "GraphTester::test16 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     test walking the outgoing edges of a vertex: the range, the indexed
+     lookup and the list agree with the edges added, loops included, and a
+     copied graph walks its own edges
+     */
+    static TestResults* test17() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        Graph<int, int> g;
+        Vertex<int>* vertices[8];
+        for (int k = 0; k < 8; k++) {
+            vertices[k] = new Vertex<int>();
+            g.addVertex(vertices[k]);
+        }
+        int values[8] = { 0, 10, 20, 30, 40, 50, 60, 70 };
+        // vertex 0 gets more edges than fit inline, including a loop and a
+        // repeated edge
+        for (int k = 1; k < 8; k++) {
+            g.addEdge(vertices[0], vertices[k]);
+            g.setEdgeWeight(k * 0.5, vertices[0], vertices[k]);
+            g.storeInEdge(&values[k], vertices[0], vertices[k]);
+        }
+        g.addEdge(vertices[0], vertices[3]);
+        g.addEdge(vertices[0], vertices[0]);
+        g.addEdge(vertices[5], vertices[0]);
+        // the range yields (neighbour, weight, data) in the order added
+        pointsPossible++;
+        int k = 1;
+        bool correct = true;
+        for (Edge<int, int>* edge : g.getOutgoingEdgeRange(vertices[0])) {
+            Vertex<int>* expected = k < 8 ? vertices[k] : vertices[0];
+            correct = correct && edge->getInitialVertex() == vertices[0] && edge->getTerminalVertex() == expected;
+            if (k < 8) {
+                correct = correct && edge->getWeight() == k * 0.5 && edge->getData() == &values[k];
+            }
+            k++;
+        }
+        if (correct && k == 9) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the outgoing edge range of vertex 0 was wrong" << std::endl;
+        }
+        // the indexed lookup and the list give the same edges
+        pointsPossible++;
+        List<Edge<int, int>>* outEdges = g.getOutgoingEdges(vertices[0]);
+        correct = outEdges->getSize() == 8 && g.getOutgoingEdge(vertices[0], 8) == nullptr;
+        for (k = 0; k < outEdges->getSize(); k++) {
+            Edge<int, int>* edge = g.getOutgoingEdge(vertices[0], k);
+            correct = correct && edge == outEdges->peek(k) && g.getEdgeIndex(edge) >= 0;
+        }
+        delete outEdges;
+        if (correct && g.getOutgoingEdge(vertices[5], 0) == g.getEdges().peek(g.getNumEdges() - 1)) {
+            pointsEarned++;
+        }
+        else {
+            sout << "getOutgoingEdge and getOutgoingEdges disagreed" << std::endl;
+        }
+        // vertices without outgoing edges, or outside the graph, have none
+        pointsPossible++;
+        Vertex<int> stranger;
+        Graph<int, int>::OutgoingEdgeRange none = g.getOutgoingEdgeRange(&stranger);
+        if (none.begin() == none.end() && g.getOutgoingEdge(&stranger, 0) == nullptr
+            && g.getOutgoingEdgeRange(vertices[1]).begin() == g.getOutgoingEdgeRange(vertices[1]).end()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a vertex with no outgoing edges had some" << std::endl;
+        }
+        // a copy walks its own edges, with the same weights
+        pointsPossible++;
+        Graph<int, int> copy(g);
+        Vertex<int>* copyStart = copy.getVertex(0);
+        k = 1;
+        correct = true;
+        for (Edge<int, int>* edge : copy.getOutgoingEdgeRange(copyStart)) {
+            correct = correct && edge->getInitialVertex() == copyStart && copy.getEdgeIndex(edge) >= 0 && g.getEdgeIndex(edge) < 0;
+            if (k < 8) {
+                correct = correct && edge->getTerminalVertex() == copy.getVertex(k) && edge->getWeight() == k * 0.5;
+            }
+            k++;
+        }
+        if (correct && k == 9) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a copied graph walked the wrong outgoing edges" << std::endl;
+        }
+        std::cout << "GraphTester::test17 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     test getEdge and the other index-based edge operations on a graph with
+     many edges, including after copying and moving it
+     */
+    static TestResults* test18() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        int numVertices = 200;
+        Graph<int, int>* g = new Graph<int, int>();
+        Vertex<int>** vertices = new Vertex<int>*[numVertices];
+        for (int k = 0; k < numVertices; k++) {
+            vertices[k] = new Vertex<int>();
+            g->addVertex(vertices[k]);
+        }
+        for (int k = 0; k < numVertices; k++) {
+            for (int j = 1; j <= 10; j++) {
+                g->addEdge(vertices[k], vertices[(k * 7 + j) % numVertices]);
+            }
+        }
+        int numEdges = g->getNumEdges();
+        // getEdge follows the order of the edge list, and nothing else
+        pointsPossible++;
+        bool correct = numEdges == numVertices * 10 && g->getEdge(-1) == nullptr && g->getEdge(numEdges) == nullptr;
+        int k = 0;
+        for (Edge<int, int>* edgeK : g->getEdges()) {
+            correct = correct && g->getEdge(k) == edgeK && g->getEdgeIndex(g->getEdge(k)) == k && g->getEdges().getIndex(edgeK) == k;
+            k++;
+        }
+        if (correct) {
+            pointsEarned++;
+        }
+        else {
+            sout << "getEdge disagreed with the edge list" << std::endl;
+        }
+        // a batch update by index, read back by index and by vertices
+        pointsPossible++;
+        int* values = new int[numEdges];
+        for (k = 0; k < numEdges; k++) {
+            values[k] = k;
+            g->setEdgeWeight(k + 0.25, k);
+            g->storeInEdge(&values[k], k);
+        }
+        correct = g->setEdgeWeight(1, numEdges) < 0 && g->storeInEdge(values, -1) < 0;
+        correct = correct && std::isnan(g->getEdgeWeight(numEdges)) && g->getEdgeData(numEdges) == nullptr;
+        for (k = 0; k < numEdges; k++) {
+            Edge<int, int>* edgeK = g->getEdge(k);
+            correct = correct && g->getEdgeWeight(k) == k + 0.25 && g->getEdgeData(k) == &values[k];
+            correct = correct && g->getEdgeWeight(edgeK->getInitialVertex(), edgeK->getTerminalVertex()) == k + 0.25;
+        }
+        if (correct) {
+            pointsEarned++;
+        }
+        else {
+            sout << "index-based edge updates were not read back" << std::endl;
+        }
+        // copies index their own edges in the same order, and moves keep them
+        pointsPossible++;
+        Graph<int, int> copy(*g);
+        Graph<int, int> moved(std::move(*g));
+        correct = g->getEdge(0) == nullptr && copy.getNumEdges() == numEdges && moved.getNumEdges() == numEdges;
+        for (k = 0; k < numEdges; k++) {
+            Edge<int, int>* original = moved.getEdge(k);
+            Edge<int, int>* copied = copy.getEdge(k);
+            correct = correct && original->getData() == &values[k] && copied != original && copied->getWeight() == k + 0.25;
+            correct = correct && copy.getVertexIndex(copied->getTerminalVertex()) == moved.getVertexIndex(original->getTerminalVertex());
+        }
+        if (correct) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a copied or moved graph lost its edge indices" << std::endl;
+        }
+        delete g;
+        delete[] vertices;
+        delete[] values;
+        std::cout << "GraphTester::test18 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     test vertex and edge IDs: they are dense and follow the order things
+     were added, membership is decided by them, objects outside the graph
+     are not members even when their IDs collide, and the ID overloads
+     agree with the vertex ones
+     */
+    static TestResults* test19() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        Graph<int, int> g;
+        Vertex<int>* a = new Vertex<int>();
+        Vertex<int>* b = new Vertex<int>();
+        Vertex<int>* c = new Vertex<int>();
+        bool correct = a->getId() < 0;
+        g.addVertex(a);
+        g.addVertex(a);
+        // b and c join through addEdge
+        g.addEdge(a, b);
+        g.addEdge(c, c);
+        g.addEdge(b, a);
+        // IDs are the indices, in the order things were added
+        pointsPossible++;
+        correct = correct && a->getId() == 0 && b->getId() == 1 && c->getId() == 2 && g.getNumVertices() == 3;
+        for (int k = 0; k < g.getNumVertices(); k++) {
+            correct = correct && g.getVertex(k)->getId() == k && g.getVertexIndex(g.getVertex(k)) == k;
+        }
+        for (int k = 0; k < g.getNumEdges(); k++) {
+            correct = correct && g.getEdge(k)->getId() == k && g.getEdgeIndex(g.getEdge(k)) == k;
+        }
+        if (correct && g.getEdge(2)->getInitialVertex() == b) {
+            pointsEarned++;
+        }
+        else {
+            sout << "vertex or edge IDs were not their indices" << std::endl;
+        }
+        // vertices and edges of another graph share IDs but aren't members
+        pointsPossible++;
+        Graph<int, int> other;
+        Vertex<int>* d = new Vertex<int>();
+        Vertex<int>* e = new Vertex<int>();
+        other.addEdge(d, e);
+        Edge<int, int> copiedEdge = *g.getEdge(0);
+        correct = d->getId() == a->getId() && !g.hasVertex(d) && !other.hasVertex(a) && g.getVertexIndex(d) < 0;
+        correct = correct && g.getInDegree(d) < 0 && g.getOutDegree(e) < 0 && !g.hasVertex(nullptr);
+        correct = correct && g.getVertices().getIndex(c) == 2 && g.getVertices().getIndex(d) < 0 && g.getVertices().getSize() == 3;
+        correct = correct && g.getEdgeIndex(other.getEdge(0)) < 0 && g.getEdgeIndex(&copiedEdge) < 0 && g.getEdgeIndex(nullptr) < 0;
+        if (correct && other.hasVertex(d) && other.getEdgeIndex(other.getEdge(0)) == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "membership was decided by IDs alone" << std::endl;
+        }
+        // the ID overloads agree with the vertex overloads
+        pointsPossible++;
+        int value = 42;
+        g.addEdge(2, 0);
+        g.addEdge(0, 7);
+        correct = g.getNumEdges() == 4 && g.hasEdge(2, 0) && g.hasEdge(c, a) && !g.hasEdge(0, 2) && !g.hasEdge(0, 7);
+        correct = correct && g.getInDegree(0) == g.getInDegree(a) && g.getOutDegree(2) == 2 && g.getInDegree(3) < 0;
+        correct = correct && g.setEdgeWeight(2.5, 0, 1) == 0 && g.getEdgeWeight(a, b) == 2.5 && g.getEdgeWeight(1, 0) == 1;
+        correct = correct && g.setEdgeWeight(1, 1, 2) < 0 && std::isnan(g.getEdgeWeight(1, 2));
+        correct = correct && g.storeInEdge(&value, 2, 2) == 0 && g.getEdgeData(c, c) == &value && g.getEdgeData(2, 2) == &value;
+        correct = correct && g.storeInEdge(&value, 5, 2) < 0 && g.getEdgeData(0, 5) == nullptr;
+        int numOutgoing = 0;
+        for (Edge<int, int>* edge : g.getOutgoingEdgeRange(2)) {
+            correct = correct && edge->getInitialVertex() == c;
+            numOutgoing++;
+        }
+        if (correct && numOutgoing == 2) {
+            pointsEarned++;
+        }
+        else {
+            sout << "an ID overload disagreed with its vertex overload" << std::endl;
+        }
+        // IDs index flat arrays, here counting in-degrees edge by edge
+        pointsPossible++;
+        int* inDegrees = new int[g.getNumVertices()]();
+        for (Edge<int, int>* edge : g.getEdges()) {
+            inDegrees[edge->getTerminalVertex()->getId()]++;
+        }
+        correct = true;
+        for (int k = 0; k < g.getNumVertices(); k++) {
+            correct = correct && inDegrees[k] == g.getInDegree(k);
+        }
+        delete[] inDegrees;
+        if (correct) {
+            pointsEarned++;
+        }
+        else {
+            sout << "in-degrees counted by ID were wrong" << std::endl;
+        }
+        // null vertices are ignored rather than given IDs
+        pointsPossible++;
+        int numVertices = g.getNumVertices();
+        int numEdges = g.getNumEdges();
+        g.addVertex(nullptr);
+        g.addEdge(nullptr, a);
+        g.addEdge(a, nullptr);
+        g.addEdge(nullptr, nullptr);
+        if (g.getNumVertices() == numVertices && g.getNumEdges() == numEdges && !g.hasEdge(a, nullptr)) {
+            pointsEarned++;
+        }
+        else {
+            sout << "adding a null vertex changed the graph" << std::endl;
+        }
+        std::cout << "GraphTester::test19 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
     static TestResults* testX() {
         std::ostringstream sout;
         int pointsPossible = 0;
@@ -1295,6 +1837,36 @@ public:
         totalEarned += r->pointsEarned;
         std::cout << r->toString() << std::endl;
 
+        r = test14();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test15();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test16();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test17();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test18();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test19();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
         return new TestResults(totalPossible, totalEarned, "");
     }
 
@@ -1,23 +1,106 @@
 #pragma once
 
+#include <functional>
+#include <initializer_list>
 #include <iostream>
+#include <iterator>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <utility>
 
+#include "ArrayList.h"
 #include "Chain.h"
+#include "ListIndex.h"
+#include "ListStorage.h"
+#include "UnrolledList.h"
 
 /*
  A templated class representing lists. A List<T> manages pointers to objects of type T.
+
+ The second template argument is the storage policy (see ListStorage.h).
+ This is the linked implementation, used with the node allocator policies;
+ List<T, ContiguousStorage> is implemented in ArrayList.h, and
+ List<T, UnrolledStorage<ChunkSize>> in UnrolledList.h.
  */
-template <typename T>
-class List : public Chain<T> {
+template <typename T, typename Allocator>
+class List : public Chain<T, Allocator> {
 
 protected:
 
+    /*
+     Optional hash index from data pointers to positions, used by getIndex.
+     It is null until indexing is enabled and the list has reached
+     indexThreshold nodes. A negative indexThreshold means indexing is
+     disabled.
+     */
+    std::unique_ptr<ListIndex<T>> index;
+    int indexThreshold;
+
+    /*
+     Marks the index, if there is one, as out of date.
+     */
+    void invalidateIndex() {
+        if (this->index != nullptr) {
+            this->index->invalidate();
+        }
+    }
+
+    /*
+     Forgets the nodes of this list without releasing them, after they have
+     been linked into another list.
+     */
+    void releaseNodes() {
+        this->startNode = nullptr;
+        this->endNode = nullptr;
+        this->numNodes = 0;
+        this->invalidateCursor();
+        this->invalidateIndex();
+    }
+
+    /*
+     Reserves nodes for the range [first, last) when its length can be
+     found without consuming it.
+     */
+    template <typename ForwardIterator>
+    void reserveFor(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+        this->reserve(static_cast<int>(std::distance(first, last)));
+    }
+
+    template <typename InputIterator>
+    void reserveFor(InputIterator first, InputIterator last, std::input_iterator_tag) {}
+
+    /*
+     Merges two runs of nodes linked through their next pointers, each
+     sorted by the specified ordering, and returns the first node of the
+     result. On ties, nodes of the first run come first. Previous pointers
+     are left for the caller to fix.
+     */
+    template <typename Compare>
+    static Node<T>* mergeRuns(Node<T>* first, Node<T>* second, Compare& less) {
+        Node<T> head;
+        Node<T>* last = &head;
+        while (first != nullptr && second != nullptr) {
+            if (less(*second->getData(), *first->getData())) {
+                last->setNextNode(second);
+                second = second->getNextNode();
+            }
+            else {
+                last->setNextNode(first);
+                first = first->getNextNode();
+            }
+            last = last->getNextNode();
+        }
+        last->setNextNode(first != nullptr ? first : second);
+        return head.getNextNode();
+    }
+
     /*
      Creates a list consisting of the specified node.
      */
     List(Node<T>* existingNode) {
+        this->invalidateCursor();
+        this->indexThreshold = -1;
         if (existingNode == nullptr) {
             this->startNode = nullptr;
             this->endNode = nullptr;
@@ -51,7 +134,183 @@ public:
     /*
      Creates an empty list.
      */
-    List() : Chain<T>() {}
+    List() : Chain<T, Allocator>() {
+        this->indexThreshold = -1;
+    }
+
+    /*
+     Creates a list holding the same data pointers as the specified one. The
+     copy indexes itself under the same threshold, but builds its own index
+     on first use.
+     */
+    List(const List<T, Allocator>& other) : Chain<T, Allocator>(other) {
+        this->indexThreshold = other.indexThreshold;
+    }
+
+    /*
+     Creates a list that takes over the nodes and index of the specified
+     one, leaving it empty.
+     */
+    List(List<T, Allocator>&& other) : Chain<T, Allocator>(std::move(other)) {
+        this->indexThreshold = other.indexThreshold;
+        this->index = std::move(other.index);
+    }
+
+    List<T, Allocator>& operator=(const List<T, Allocator>& other) {
+        if (this != &other) {
+            Chain<T, Allocator>::operator=(other);
+            this->indexThreshold = other.indexThreshold;
+            this->index.reset();
+        }
+        return *this;
+    }
+
+    List<T, Allocator>& operator=(List<T, Allocator>&& other) {
+        if (this != &other) {
+            Chain<T, Allocator>::operator=(std::move(other));
+            this->indexThreshold = other.indexThreshold;
+            this->index = std::move(other.index);
+        }
+        return *this;
+    }
+
+    /*
+     Removes every element from this list. The data is left alone.
+     */
+    void clear() {
+        Chain<T, Allocator>::clear();
+        this->index.reset();
+    }
+
+    /*
+     Creates a list containing the specified data, in order.
+     */
+    List(std::initializer_list<T*> items) : List() {
+        this->insertRange(0, items.begin(), items.end());
+    }
+
+    /*
+     Creates a list containing the data in the range [first, last), in
+     order.
+     */
+    template <typename InputIterator>
+    List(InputIterator first, InputIterator last) : List() {
+        this->insertRange(0, first, last);
+    }
+
+    /*
+     Makes sure the next numNodes insertions into lists of this type can be
+     served by the allocator without going back to the system more than
+     once. Does nothing for allocators without a pool.
+     */
+    void reserve(int numNodes) {
+        Allocator::template reserve<Node<T>>(numNodes);
+    }
+
+    /*
+     Inserts the data in the range [first, last) into this list, in order,
+     starting at the specified position. Positions are clamped as in
+     insertAtPosition. Nodes for the whole range are reserved up front when
+     its length is known, and the range is linked into a separate chain that
+     is spliced in with a single relink.
+     */
+    template <typename InputIterator>
+    void insertRange(int position, InputIterator first, InputIterator last) {
+        this->reserveFor(first, last, typename std::iterator_traits<InputIterator>::iterator_category());
+        if (position >= this->numNodes) {
+            // appending keeps the cursor and the index exact
+            for (; first != last; ++first) {
+                this->insertAtEnd(*first);
+            }
+        }
+        else {
+            List<T, Allocator> batch;
+            for (; first != last; ++first) {
+                batch.insertAtEnd(*first);
+            }
+            this->splice(position <= 0 ? nullptr : this->getNodeAt(position - 1), &batch);
+        }
+    }
+
+    /*
+     Enables the hash index used by getIndex. The index is only built once
+     this list has at least the specified number of nodes; below that a
+     linear scan is as fast and saves the memory. Once built, the index is
+     kept up to date by changes at either end of this list; a change in the
+     middle makes getIndex scan until lookups repeat with no change in
+     between, and only then is the index rebuilt. See ListIndex.
+     */
+    void enableIndex(int minimumSize = 0) {
+        this->indexThreshold = minimumSize < 0 ? 0 : minimumSize;
+    }
+
+    /*
+     Disables the hash index and releases its memory.
+     */
+    void disableIndex() {
+        this->indexThreshold = -1;
+        this->index.reset();
+    }
+
+    /*
+     Returns true if and only if indexing is enabled for this list.
+     */
+    bool isIndexed() {
+        return this->indexThreshold >= 0;
+    }
+
+    /*
+     Sets the data of the node in the specified position. If the position
+     does not exist in this list, this method does nothing.
+     */
+    void setData(T* data, int position) {
+        this->invalidateIndex();
+        Chain<T, Allocator>::setData(data, position);
+    }
+
+    /*
+     Inserts the specified data at the beginning of this list.
+     */
+    void insertAtStart(T* data) {
+        Chain<T, Allocator>::insertAtStart(data);
+        if (this->index != nullptr) {
+            this->index->insertedAtStart(data);
+        }
+    }
+
+    /*
+     Inserts the specified data at the end of this list.
+     */
+    void insertAtEnd(T* data) {
+        Chain<T, Allocator>::insertAtEnd(data);
+        if (this->index != nullptr) {
+            this->index->insertedAtEnd(data, this->numNodes - 1);
+        }
+    }
+
+    /*
+     Removes the node at the start of this list, and returns its data.
+     */
+    T* removeFromStart() {
+        bool wasEmpty = this->isEmpty();
+        T* result = Chain<T, Allocator>::removeFromStart();
+        if (this->index != nullptr && !wasEmpty) {
+            this->index->removedFromStart(result);
+        }
+        return result;
+    }
+
+    /*
+     Removes the node at the end of this list, and returns its data.
+     */
+    T* removeFromEnd() {
+        bool wasEmpty = this->isEmpty();
+        T* result = Chain<T, Allocator>::removeFromEnd();
+        if (this->index != nullptr && !wasEmpty) {
+            this->index->removedFromEnd(result);
+        }
+        return result;
+    }
 
     /*
      Returns the index of the first occurance of the specified
@@ -61,17 +320,34 @@ public:
      Note: the specified data is considered to be in this chain
      iff its pointer has the same value as one of the pointers
      managed by this list.
+
+     If indexing is enabled and the index is up to date this takes O(1)
+     expected time, otherwise it scans the list.
      */
     int getIndex(T* data) {
+        if (this->index == nullptr && this->isIndexed() && this->numNodes >= this->indexThreshold) {
+            this->index.reset(new ListIndex<T>());
+        }
+        if (this->index != nullptr) {
+            if (this->index->isStale() && this->index->rebuildDue()) {
+                this->index->rebuild(this->begin(), this->end());
+                // the rebuild walks every node
+                this->recordHops(&ListStatistics::indexHops, this->numNodes);
+            }
+            if (!this->index->isStale()) {
+                return this->index->find(data);
+            }
+        }
         int result = -1;
-        int sz = this->getSize();
-        for (int k = 0; k < sz; k++) {
-            T* peekResult = this->peek(k);
-            if (peekResult == data) {
+        int k = 0;
+        for (T* item : *this) {
+            if (item == data) {
                 result = k;
                 break;
             }
+            k++;
         }
+        this->recordHops(&ListStatistics::indexHops, k);
         return result;
     }
 
@@ -83,62 +359,166 @@ public:
      */
     T* removeFromPosition(int position) {
         T* result;
-        if (this->isEmpty()) {
-            // return nullptr if this list is empty
+        if (position < 0 || position >= this->numNodes) {
+            // return nullptr if there is no node in the specified position
             result = nullptr;
         }
-        else if (this->numNodes == 1) {
-            // if this list contains exactly 1 node, only
-            // can return data from position 0.
-            if (position != 0) {
-                result = nullptr;
-            }
-            else {
-                // get data
-                result = this->removeFromEnd();
-            }
+        else if (position == 0) {
+            result = this->removeFromStart();
         }
-        else {
-            // get the node in the specified position
-            Node<T>* currentNode = this->startNode;
-            for (int k = 0; k < position; k++) {
-                currentNode = currentNode->getNextNode();
-            }
-            // currentNode is now the node in the specified position
-            List<T>* lastHalf = this->splitAfter(position);
-            // remove the node and get the data
+        else if (position == this->numNodes - 1) {
             result = this->removeFromEnd();
-            // put the two halves back together
-            this->append(lastHalf);
+        }
+        else {
+            // getNodeAt leaves the cursor on the node, and erase moves it
+            // to the node that takes over this position
+            result = this->erase(this->getNodeAt(position));
         }
         return result;
     }
 
     /*
      Inserts the specified data into the list as a new node in
-     the specified position.
-     TODO: what if position isn't a valid location in the list?
+     the specified position. Positions before the start of the list insert
+     at the start, and positions after the end insert at the end.
      */
     void insertAtPosition(int position, T* data) {
-        if (this->isEmpty()) {
-            this->startNode = new Node<T>(data);
-            this->endNode = this->startNode;
-            this->numNodes = 1;
+        if (this->isEmpty() || position <= 0) {
+            this->insertAtStart(data);
         }
-        else if (position == 0) {
-            Node<T>* newStart = new Node<T>(data);
-            this->startNode->setPreviousNode(newStart);
-            newStart->setNextNode(this->startNode);
-            this->startNode = newStart;
-            this->numNodes++;
+        else if (position >= this->numNodes) {
+            this->insertAtEnd(data);
         }
         else {
-            List<T>* lastHalf = this->splitAfter(position - 1);
-            // insertAtEnd will increment numNodes, so we don't have
-            // to do it here
+            // getNodeAt leaves the cursor on the predecessor, which stays
+            // valid across insertAfter
+            this->insertAfter(this->getNodeAt(position - 1), data);
+        }
+    }
+
+    /*
+     Returns a handle to the node at the specified position, or the null
+     pointer if there is no node in that position. A handle stays valid
+     until its node is removed from this list, whatever happens to the
+     nodes around it, so it can be used for O(1) insertion and removal.
+     Iterator::getNode also returns handles.
+     */
+    Node<T>* getHandle(int position) {
+        return this->getNodeAt(position);
+    }
+
+    /*
+     Inserts the specified data in a new node after the node with the
+     specified handle, and returns a handle to the new node. If the handle
+     is the null pointer, the data is inserted at the start of this list.
+     Takes O(1) time.
+     */
+    Node<T>* insertAfter(Node<T>* handle, T* data) {
+        Node<T>* result;
+        if (handle == nullptr) {
+            this->insertAtStart(data);
+            result = this->startNode;
+        }
+        else if (handle == this->endNode) {
             this->insertAtEnd(data);
-            this->append(lastHalf);
-            //            this->numNodes++;
+            result = this->endNode;
+        }
+        else {
+            result = this->createNode(data);
+            Node<T>* next = handle->getNextNode();
+            result->setPreviousNode(handle);
+            result->setNextNode(next);
+            handle->setNextNode(result);
+            next->setPreviousNode(result);
+            this->numNodes++;
+            // the cursor can only be kept if it is known to be before
+            // the new node
+            if (this->cursorNode != handle) {
+                this->invalidateCursor();
+            }
+            this->invalidateIndex();
+        }
+        return result;
+    }
+
+    /*
+     Inserts the specified data in a new node before the node with the
+     specified handle, and returns a handle to the new node. If the handle
+     is the null pointer, the data is inserted at the end of this list.
+     Takes O(1) time.
+     */
+    Node<T>* insertBefore(Node<T>* handle, T* data) {
+        Node<T>* result;
+        if (handle == nullptr) {
+            this->insertAtEnd(data);
+            result = this->endNode;
+        }
+        else {
+            result = this->insertAfter(handle->getPreviousNode(), data);
+        }
+        return result;
+    }
+
+    /*
+     Removes the node with the specified handle from this list, and returns
+     its data. The handle must belong to this list, and is no longer valid
+     afterwards. Takes O(1) time.
+     */
+    T* erase(Node<T>* handle) {
+        T* result;
+        if (handle == this->startNode) {
+            result = this->removeFromStart();
+        }
+        else if (handle == this->endNode) {
+            result = this->removeFromEnd();
+        }
+        else {
+            result = handle->getData();
+            Node<T>* previous = handle->getPreviousNode();
+            Node<T>* next = handle->getNextNode();
+            previous->setNextNode(next);
+            next->setPreviousNode(previous);
+            this->numNodes--;
+            if (this->cursorNode == handle) {
+                // the next node moves into the erased node's position
+                this->cursorNode = next;
+            }
+            else {
+                this->invalidateCursor();
+            }
+            this->invalidateIndex();
+            this->destroyNode(handle);
+        }
+        return result;
+    }
+
+    /*
+     Moves all nodes of the specified list into this one, after the node
+     with the specified handle, leaving the specified list empty. If the
+     handle is the null pointer, the nodes are moved to the start of this
+     list. Takes O(1) time.
+     */
+    void splice(Node<T>* handle, List<T, Allocator>* other) {
+        if (!other->isEmpty()) {
+            if (handle == nullptr) {
+                this->prepend(other);
+            }
+            else if (handle == this->endNode) {
+                this->append(other);
+            }
+            else {
+                Node<T>* next = handle->getNextNode();
+                handle->setNextNode(other->startNode);
+                other->startNode->setPreviousNode(handle);
+                other->endNode->setNextNode(next);
+                next->setPreviousNode(other->endNode);
+                this->numNodes += other->numNodes;
+                if (this->cursorNode != handle) {
+                    this->invalidateCursor();
+                }
+                this->invalidateIndex();
+                other->releaseNodes();
+            }
         }
     }
 
@@ -147,25 +527,22 @@ public:
      nodes after that position from this list, and returning these
      nodes as another list.
      */
-    List<T>* splitAfter(int position) {
-        List<T>* result;
+    List<T, Allocator>* splitAfter(int position) {
+        List<T, Allocator>* result;
         if (this->numNodes < 2) {
             // can't split, so return an empty list
-            result = new List<T>();
+            result = new List<T, Allocator>();
         }
         else {
             // get node at specified position
-            Node<T>* currentNode = this->startNode;
-            for (int k = 0; k < position; k++) {
-                currentNode = currentNode->getNextNode();
-            }
-            // currentNode is now the node at the specified position
+            Node<T>* currentNode = this->getNodeAt(position);
             // if currentNode == endNode, the split does nothing
-            if (currentNode == this->endNode) {
+            if (currentNode == nullptr || currentNode == this->endNode) {
                 // the split does nothing, so return an empty list
-                result = new List<T>();
+                result = new List<T, Allocator>();
             }
             else {
+                this->invalidateIndex();
                 // otherwise currentNode->getNextNode() will be the new
                 // root of the returned list
                 Node<T>* newRoot = currentNode->getNextNode();
@@ -175,22 +552,25 @@ public:
                 currentNode->setNextNode(nullptr);
                 // the end node of this list should now be the current node
                 this->endNode = currentNode;
-                // update the number of nodes in this list
+                // update the number of nodes in this list. The cursor was
+                // left at currentNode, which stays in this list.
                 this->numNodes = position + 1;
                 // create the list consisting of the nodes after the
                 // specified position
-                result = new List<T>(newRoot);
+                result = new List<T, Allocator>(newRoot);
             }
         }
         return result;
     }
 
     /*
-     Appends the specified list to this one.
+     Appends the specified list to this one, leaving the specified list
+     empty: its nodes now belong to this list.
      */
-    void append(List<T>* suffix) {
+    void append(List<T, Allocator>* suffix) {
         // if suffix is empty we do nothing
         if (!suffix->isEmpty()) {
+            this->invalidateIndex();
             if (this->isEmpty()) {
                 this->startNode = suffix->startNode;
                 this->endNode = suffix->endNode;
@@ -202,15 +582,18 @@ public:
                 this->endNode = suffix->endNode;
                 this->numNodes += suffix->getSize();
             }
+            suffix->releaseNodes();
         }
     }
 
     /*
-     Prepends the specified list to this one.
+     Prepends the specified list to this one, leaving the specified list
+     empty: its nodes now belong to this list.
      */
-    void prepend(List<T>* prefix) {
+    void prepend(List<T, Allocator>* prefix) {
         // if prefix is empty do nothing
         if (!prefix->isEmpty()) {
+            this->invalidateIndex();
             if (this->isEmpty()) {
                 this->startNode = prefix->startNode;
                 this->endNode = prefix->endNode;
@@ -221,8 +604,126 @@ public:
                 prefix->endNode->setNextNode(this->startNode);
                 this->startNode = prefix->startNode;
                 this->numNodes += prefix->getSize();
+                // the prefix shifts every existing node along
+                this->cursorPosition += prefix->getSize();
+            }
+            prefix->releaseNodes();
+        }
+    }
+
+    /*
+     Removes every node whose data satisfies the specified predicate, a
+     function object taking a T* and returning bool, in a single pass over
+     this list. The remaining nodes keep their order. Returns the number of
+     nodes removed.
+     */
+    template <typename Predicate>
+    int removeIf(Predicate predicate) {
+        int numRemoved = 0;
+        Node<T>* previous = nullptr;
+        Node<T>* node = this->startNode;
+        while (node != nullptr) {
+            Node<T>* next = node->getNextNode();
+            if (predicate(node->getData())) {
+                if (previous == nullptr) {
+                    this->startNode = next;
+                }
+                else {
+                    previous->setNextNode(next);
+                }
+                if (next != nullptr) {
+                    next->setPreviousNode(previous);
+                }
+                this->destroyNode(node);
+                numRemoved++;
+            }
+            else {
+                previous = node;
             }
+            node = next;
         }
+        if (numRemoved > 0) {
+            this->endNode = previous;
+            this->numNodes -= numRemoved;
+            this->invalidateCursor();
+            this->invalidateIndex();
+        }
+        return numRemoved;
+    }
+
+    /*
+     Removes every occurrence of the specified data pointer from this list
+     in a single pass, and returns the number removed.
+     */
+    int removeAll(T* data) {
+        return this->removeIf([data](T* item) { return item == data; });
+    }
+
+    /*
+     Removes every node whose data does not satisfy the specified predicate
+     in a single pass, and returns the number removed.
+     */
+    template <typename Predicate>
+    int retainIf(Predicate predicate) {
+        return this->removeIf([&predicate](T* item) { return !predicate(item); });
+    }
+
+    /*
+     Sorts this list by the data its nodes point to, using the specified
+     ordering over T (a strict weak ordering, like std::less<T>). The sort
+     is stable, takes O(n log n) time, and relinks the existing nodes
+     without allocating: handles stay valid and follow their data.
+     */
+    template <typename Compare>
+    void sort(Compare less) {
+        if (this->numNodes < 2) {
+            return;
+        }
+        // bottom-up merge sort: runs[k] is empty or holds a sorted run of
+        // 2^k nodes, each taken from further back than the runs before it
+        const int maxRuns = 64;
+        Node<T>* runs[maxRuns] = {};
+        int numRuns = 0;
+        Node<T>* node = this->startNode;
+        while (node != nullptr) {
+            Node<T>* next = node->getNextNode();
+            node->setNextNode(nullptr);
+            Node<T>* carry = node;
+            int k = 0;
+            while (runs[k] != nullptr) {
+                carry = mergeRuns(runs[k], carry, less);
+                runs[k] = nullptr;
+                k++;
+            }
+            runs[k] = carry;
+            if (k >= numRuns) {
+                numRuns = k + 1;
+            }
+            node = next;
+        }
+        Node<T>* result = nullptr;
+        for (int k = 0; k < numRuns; k++) {
+            if (runs[k] != nullptr) {
+                result = result == nullptr ? runs[k] : mergeRuns(runs[k], result, less);
+            }
+        }
+        // restore the previous pointers
+        Node<T>* previous = nullptr;
+        for (node = result; node != nullptr; node = node->getNextNode()) {
+            node->setPreviousNode(previous);
+            previous = node;
+        }
+        this->startNode = result;
+        this->endNode = previous;
+        this->invalidateCursor();
+        this->invalidateIndex();
+    }
+
+    /*
+     Sorts this list by the data its nodes point to, in ascending order.
+     */
+    void sort() {
+        this->sort(std::less<T>());
     }
 
     /*
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "List.h"
+#include "NodeAllocator.h"
+
+/*
+ Times the same workloads on each List storage policy, so the node-per-
+ element chain can be compared with the unrolled and contiguous lists.
+ Run it with TextualRPG --benchmark; build in Release for meaningful
+ numbers.
+ */
+class ListBenchmark {
+
+protected:
+
+    typedef std::chrono::steady_clock Clock;
+
+    /*
+     Returns the milliseconds elapsed since the specified time.
+     */
+    static double millisecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    /*
+     Runs the workloads on one list type and returns a line of results.
+     The workloads are: appending n elements, a full traversal, n random
+     peeks, n/4 insertions followed by n/4 removals at random positions, and
+     sorting the result in descending order.
+     The allocation count covers the node allocators only, so it is zero for
+     the contiguous list. The checksum keeps the compiler from discarding
+     the traversals.
+     */
+    template <typename ListType>
+    static std::string runWorkloads(std::string name, int n) {
+        int* values = new int[n];
+        for (int k = 0; k < n; k++) {
+            values[k] = k;
+        }
+        long allocationsBefore = SystemAllocationCounter::getCount();
+        ListType* list = new ListType();
+        long checksum = 0;
+        unsigned int seed = 4242;
+
+        Clock::time_point start = Clock::now();
+        for (int k = 0; k < n; k++) {
+            list->insertAtEnd(&values[k]);
+        }
+        double appendTime = millisecondsSince(start);
+
+        start = Clock::now();
+        for (int* item : *list) {
+            checksum += *item;
+        }
+        double scanTime = millisecondsSince(start);
+
+        start = Clock::now();
+        for (int k = 0; k < n; k++) {
+            seed = seed * 1103515245 + 12345;
+            checksum += *list->peek(static_cast<int>((seed >> 8) % n));
+        }
+        double peekTime = millisecondsSince(start);
+
+        start = Clock::now();
+        for (int k = 0; k < n / 4; k++) {
+            seed = seed * 1103515245 + 12345;
+            list->insertAtPosition(static_cast<int>((seed >> 8) % list->getSize()), &values[k]);
+        }
+        for (int k = 0; k < n / 4; k++) {
+            seed = seed * 1103515245 + 12345;
+            list->removeFromPosition(static_cast<int>((seed >> 8) % list->getSize()));
+        }
+        double middleTime = millisecondsSince(start);
+
+        start = Clock::now();
+        list->sort(std::greater<int>());
+        double sortTime = millisecondsSince(start);
+        checksum += *list->peek(0);
+        long allocations = SystemAllocationCounter::getCount() - allocationsBefore;
+        delete list;
+        delete[] values;
+
+        std::ostringstream sout;
+        sout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(2)
+            << std::setw(12) << appendTime
+            << std::setw(12) << scanTime
+            << std::setw(12) << peekTime
+            << std::setw(14) << middleTime
+            << std::setw(12) << sortTime
+            << std::setw(14) << allocations
+            << "   (checksum " << checksum << ")" << std::endl;
+        return sout.str();
+    }
+
+public:
+
+    /*
+     Runs the workloads on every storage policy with n elements, and
+     returns a table of the results in milliseconds.
+     */
+    static std::string runAll(int n) {
+        std::ostringstream sout;
+        sout << "List benchmark, " << n << " elements (times in ms)" << std::endl;
+        sout << std::left << std::setw(24) << "storage" << std::right
+            << std::setw(12) << "append"
+            << std::setw(12) << "scan"
+            << std::setw(12) << "peek"
+            << std::setw(14) << "mid ins/rem"
+            << std::setw(12) << "sort"
+            << std::setw(14) << "sys allocs" << std::endl;
+        sout << runWorkloads<List<int, HeapNodeAllocator>>("node per element (heap)", n);
+        sout << runWorkloads<List<int, PooledNodeAllocator>>("node per element (pool)", n);
+        sout << runWorkloads<List<int, UnrolledStorage<16>>>("unrolled, 16 per chunk", n);
+        sout << runWorkloads<List<int, UnrolledStorage<64>>>("unrolled, 64 per chunk", n);
+        sout << runWorkloads<List<int, ContiguousStorage>>("contiguous", n);
+        return sout.str();
+    }
+
+};
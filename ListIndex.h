@@ -0,0 +1,185 @@
+#pragma once
+
+#include <unordered_map>
+
+/*
+ A hash index from the data pointers managed by a list to the position of
+ their first occurrence in that list. The owning list reports every change
+ it makes, so membership tests and index lookups cost O(1) expected time.
+
+ Insertions and removals at either end of the list are tracked exactly.
+ Positions are stored relative to a base that moves when the list grows or
+ shrinks at its start, so those operations don't renumber the entries.
+ Changes in the middle of the list mark the index as stale. While it is
+ stale the owning list answers lookups by scanning, and only rebuilds the
+ index once scansBeforeRebuild lookups in a row have found it stale with
+ no change in between. A list that alternates changes in the middle with
+ lookups therefore scans as it would without an index, instead of paying
+ for a rebuild after every change.
+ */
+template <typename T>
+class ListIndex {
+
+protected:
+
+    /*
+     The first occurrence of a data pointer, as an offset from base, and the
+     number of times the pointer occurs in the list.
+     */
+    struct Entry {
+        int first;
+        int count;
+    };
+
+    /*
+     The entries, keyed by data pointer.
+     */
+    std::unordered_map<T*, Entry> entries;
+
+    /*
+     The position of the entry with offset first is first - base.
+     */
+    int base;
+
+    /*
+     True if and only if the entries no longer describe the list.
+     */
+    bool stale;
+
+    /*
+     Number of lookups that have found this index stale since it was last
+     changed or rebuilt, and the number the owning list answers by scanning
+     before rebuilding.
+     */
+    int staleLookups;
+    static const int scansBeforeRebuild = 2;
+
+public:
+
+    /*
+     Creates a stale index, which will be built on first use.
+     */
+    ListIndex() {
+        this->base = 0;
+        this->stale = true;
+        this->staleLookups = 0;
+    }
+
+    /*
+     Returns true if and only if this index must be rebuilt before use.
+     */
+    bool isStale() {
+        return this->stale;
+    }
+
+    /*
+     Marks this index as stale.
+     */
+    void invalidate() {
+        this->stale = true;
+        this->staleLookups = 0;
+    }
+
+    /*
+     Records a lookup that found this index stale, and returns true if
+     enough lookups in a row have done so that the owning list should
+     rebuild it rather than scan again.
+     */
+    bool rebuildDue() {
+        this->staleLookups++;
+        return this->staleLookups > scansBeforeRebuild;
+    }
+
+    /*
+     Rebuilds this index from the data pointers in the range [first, last),
+     taken in list order.
+     */
+    template <typename Iterator>
+    void rebuild(Iterator first, Iterator last) {
+        this->entries.clear();
+        this->base = 0;
+        int position = 0;
+        for (Iterator it = first; it != last; ++it) {
+            Entry& entry = this->entries[*it];
+            if (entry.count == 0) {
+                entry.first = position;
+            }
+            entry.count++;
+            position++;
+        }
+        this->stale = false;
+        this->staleLookups = 0;
+    }
+
+    /*
+     Returns the position of the first occurrence of the specified data, or
+     a negative number if the data is not in the list.
+     */
+    int find(T* data) {
+        int result = -1;
+        typename std::unordered_map<T*, Entry>::iterator it = this->entries.find(data);
+        if (it != this->entries.end()) {
+            result = it->second.first - this->base;
+        }
+        return result;
+    }
+
+    /*
+     Records that the specified data was inserted at the start of the list.
+     */
+    void insertedAtStart(T* data) {
+        if (!this->stale) {
+            this->base--;
+            Entry& entry = this->entries[data];
+            entry.first = this->base;
+            entry.count++;
+        }
+    }
+
+    /*
+     Records that the specified data was inserted at the end of the list,
+     which put it at the specified position.
+     */
+    void insertedAtEnd(T* data, int position) {
+        if (!this->stale) {
+            Entry& entry = this->entries[data];
+            if (entry.count == 0) {
+                entry.first = position + this->base;
+            }
+            entry.count++;
+        }
+    }
+
+    /*
+     Records that the specified data was removed from the start of the list.
+     */
+    void removedFromStart(T* data) {
+        if (!this->stale) {
+            Entry& entry = this->entries[data];
+            entry.count--;
+            if (entry.count <= 0) {
+                this->entries.erase(data);
+            }
+            else {
+                // the next occurrence could be anywhere
+                this->stale = true;
+            }
+            this->base++;
+        }
+    }
+
+    /*
+     Records that the specified data was removed from the end of the list.
+     Any other occurrence precedes it, so the first occurrence is unchanged.
+     */
+    void removedFromEnd(T* data) {
+        if (!this->stale) {
+            Entry& entry = this->entries[data];
+            entry.count--;
+            if (entry.count <= 0) {
+                this->entries.erase(data);
+            }
+        }
+    }
+
+};
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <sstream>
+#include <string>
+#include <typeinfo>
+
+#include "Node.h"
+
+/*
+ Optional statistics for the linked lists (Chain and List). Build with
+ TEXTUALRPG_LIST_STATS defined to turn them on. Without it, the counters
+ and the code that updates them compile away completely: chains get no
+ extra members, and every recording call is an empty inline function.
+
+ Each chain counts the node allocations and frees it made, and the node
+ hops it spent walking to a position in peek and setData, or scanning in
+ getIndex. The same events are added to totals per element type in
+ ListStatsRegistry, which can dump them all. Neither is thread safe,
+ like the lists themselves.
+ */
+
+/*
+ A set of counters. numNodes and bytesInUse describe the nodes alive now;
+ the other counters are totals since the counting started.
+ */
+struct ListStatistics {
+    long numNodes;
+    long bytesInUse;
+    long numAllocations;
+    long numFrees;
+    long peekHops;
+    long setDataHops;
+    long indexHops;
+
+    ListStatistics() {
+        this->numNodes = 0;
+        this->bytesInUse = 0;
+        this->numAllocations = 0;
+        this->numFrees = 0;
+        this->peekHops = 0;
+        this->setDataHops = 0;
+        this->indexHops = 0;
+    }
+
+    /*
+     Returns a one-line representation of these statistics.
+     */
+    std::string toString() const {
+        std::ostringstream sout;
+        sout << this->numNodes << " nodes in " << this->bytesInUse << " bytes, "
+            << this->numAllocations << " allocations, " << this->numFrees << " frees, hops: "
+            << this->peekHops << " peek, " << this->setDataHops << " setData, " << this->indexHops << " getIndex";
+        return sout.str();
+    }
+};
+
+/*
+ The totals per element type, for every chain in the program.
+ */
+class ListStatsRegistry {
+
+protected:
+
+    /*
+     The totals, and the size of one node, keyed by element type name.
+     std::map never moves its entries, so chains can hold on to theirs.
+     */
+    struct TypeEntry {
+        ListStatistics totals;
+        std::size_t nodeSize;
+    };
+
+    static std::map<std::string, TypeEntry>& entries() {
+        static std::map<std::string, TypeEntry> result;
+        return result;
+    }
+
+public:
+
+    /*
+     Returns the totals for the element type with the specified name,
+     creating them if needed. numNodes and bytesInUse are not kept up to
+     date here; getTotals and toString work them out.
+     */
+    static ListStatistics& totalsFor(const std::string& typeName, std::size_t nodeSize) {
+        TypeEntry& entry = entries()[typeName];
+        entry.nodeSize = nodeSize;
+        return entry.totals;
+    }
+
+    /*
+     Returns the totals for the element type with the specified name. They
+     are all zero if no chain of that type has recorded anything.
+     */
+    static ListStatistics getTotals(const std::string& typeName) {
+        ListStatistics result;
+        std::map<std::string, TypeEntry>::iterator it = entries().find(typeName);
+        if (it != entries().end()) {
+            result = it->second.totals;
+            result.numNodes = result.numAllocations - result.numFrees;
+            result.bytesInUse = result.numNodes * static_cast<long>(it->second.nodeSize);
+        }
+        return result;
+    }
+
+    /*
+     Sets every total back to zero. Nodes alive at the time will be counted
+     as negative once they are freed.
+     */
+    static void reset() {
+        for (std::map<std::string, TypeEntry>::value_type& entry : entries()) {
+            entry.second.totals = ListStatistics();
+        }
+    }
+
+    /*
+     Returns the totals for every element type, one per line, as
+     "<type name>: <statistics>".
+     */
+    static std::string toString() {
+        std::ostringstream sout;
+        for (std::map<std::string, TypeEntry>::value_type& entry : entries()) {
+            sout << entry.first << ": " << getTotals(entry.first).toString() << std::endl;
+        }
+        return sout.str();
+    }
+
+};
+
+#ifdef TEXTUALRPG_LIST_STATS
+
+/*
+ Records the events of one chain with elements of type T, and adds them to
+ the registry's totals for T. Chain derives from it. A copied or moved
+ chain starts counting from zero.
+ */
+template <typename T>
+class ListStatsRecorder {
+
+protected:
+
+    ListStatistics recorded;
+
+    static ListStatistics& typeTotals() {
+        static ListStatistics& totals = ListStatsRegistry::totalsFor(typeid(T).name(), sizeof(Node<T>));
+        return totals;
+    }
+
+    ListStatsRecorder() {}
+
+    ListStatsRecorder(const ListStatsRecorder<T>&) {}
+
+    ListStatsRecorder<T>& operator=(const ListStatsRecorder<T>&) {
+        return *this;
+    }
+
+    void recordAllocation() {
+        this->recorded.numAllocations++;
+        typeTotals().numAllocations++;
+    }
+
+    void recordFree() {
+        this->recorded.numFrees++;
+        typeTotals().numFrees++;
+    }
+
+    /*
+     Adds the specified number of hops to the specified counter, unless it
+     is the null pointer.
+     */
+    void recordHops(long ListStatistics::* counter, long hops) {
+        if (counter != nullptr) {
+            this->recorded.*counter += hops;
+            typeTotals().*counter += hops;
+        }
+    }
+
+    ListStatistics getRecorded() const {
+        return this->recorded;
+    }
+
+public:
+
+    /*
+     True if and only if statistics are compiled in.
+     */
+    static bool statisticsEnabled() {
+        return true;
+    }
+
+};
+
+#else
+
+/*
+ With statistics off, the recorder is empty and records nothing.
+ */
+template <typename T>
+class ListStatsRecorder {
+
+protected:
+
+    void recordAllocation() {}
+
+    void recordFree() {}
+
+    void recordHops(long ListStatistics::*, long) {}
+
+    ListStatistics getRecorded() const {
+        return ListStatistics();
+    }
+
+public:
+
+    static bool statisticsEnabled() {
+        return false;
+    }
+
+};
+
+#endif
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "NodeAllocator.h"
+
+/*
+ Storage policies for List. The second template argument of List selects
+ how the list stores its data pointers:
+
+   - PooledNodeAllocator: a doubly-linked chain of nodes taken from a slab
+     pool (the default).
+   - HeapNodeAllocator: a doubly-linked chain of individually allocated
+     nodes.
+   - ContiguousStorage: a single contiguous array (see ArrayList.h).
+   - UnrolledStorage<ChunkSize>: a doubly-linked chain of chunks of up to
+     ChunkSize elements each (see UnrolledList.h).
+
+ Every policy supports the same List interface.
+ */
+struct ContiguousStorage {};
+
+template <int ChunkSize = 16>
+struct UnrolledStorage {};
+
+/*
+ The storage policy used by List<T> when none is given. Build with
+ TEXTUALRPG_LIST_STORAGE defined as one of the policies above to switch
+ every list that relies on the default, including those in Graph, Vertex
+ and Player, without changing their code.
+ */
+#ifndef TEXTUALRPG_LIST_STORAGE
+#define TEXTUALRPG_LIST_STORAGE PooledNodeAllocator
+#endif
+
+typedef TEXTUALRPG_LIST_STORAGE DefaultListStorage;
+
+template <typename T, typename Storage = DefaultListStorage>
+class List;
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <sstream>
+#include <string>
+
+/*
+ A lock-free multi-producer, single-consumer FIFO queue of data pointers.
+ Any number of threads may call push at the same time, without locking;
+ pop, peek and isEmpty must only be called from one consumer thread at a
+ time.
+
+ Like Chain, the queue holds pointers to data it does not own. Each push
+ allocates one node, which the consumer frees when it pops the data.
+
+ A push becomes visible to the consumer once it has linked its node. A
+ push that has started but not finished linking can make the queue look
+ empty, or hide the pushes that follow it, for that short window; the
+ consumer just sees those elements on a later pop.
+ */
+template <typename T>
+class MPSCQueue {
+
+protected:
+
+    /*
+     A node of the queue. The consumer's head node is a placeholder whose
+     data has already been popped.
+     */
+    struct QueueNode {
+        std::atomic<QueueNode*> next;
+        T* data;
+
+        QueueNode(T* data) : next(nullptr) {
+            this->data = data;
+        }
+    };
+
+    /*
+     The most recently pushed node. Producers swap themselves in here.
+     */
+    std::atomic<QueueNode*> tail;
+
+    /*
+     The placeholder node before the next element to pop. Only the consumer
+     touches it.
+     */
+    QueueNode* head;
+
+public:
+
+    /*
+     Creates an empty queue.
+     */
+    MPSCQueue() {
+        this->head = new QueueNode(nullptr);
+        this->tail.store(this->head, std::memory_order_relaxed);
+    }
+
+    MPSCQueue(const MPSCQueue<T>&) = delete;
+    MPSCQueue<T>& operator=(const MPSCQueue<T>&) = delete;
+
+    /*
+     Releases the nodes of this queue. The data is left alone. No push may
+     be in progress.
+     */
+    ~MPSCQueue() {
+        while (this->head != nullptr) {
+            QueueNode* next = this->head->next.load(std::memory_order_relaxed);
+            delete this->head;
+            this->head = next;
+        }
+    }
+
+    /*
+     Adds the specified data to the back of this queue. Safe to call from
+     any number of threads at once.
+     */
+    void push(T* data) {
+        QueueNode* node = new QueueNode(data);
+        QueueNode* previous = this->tail.exchange(node, std::memory_order_acq_rel);
+        // until this store the consumer can't see the node, or anything
+        // pushed after it
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    /*
+     Removes the data at the front of this queue and returns it, or returns
+     the null pointer if the queue is empty. Consumer only.
+     */
+    T* pop() {
+        T* result = nullptr;
+        QueueNode* next = this->head->next.load(std::memory_order_acquire);
+        if (next != nullptr) {
+            result = next->data;
+            // the popped node becomes the new placeholder
+            delete this->head;
+            this->head = next;
+        }
+        return result;
+    }
+
+    /*
+     Returns the data at the front of this queue without removing it, or the
+     null pointer if the queue is empty. Consumer only.
+     */
+    T* peek() {
+        T* result = nullptr;
+        QueueNode* next = this->head->next.load(std::memory_order_acquire);
+        if (next != nullptr) {
+            result = next->data;
+        }
+        return result;
+    }
+
+    /*
+     Returns true if and only if the consumer has nothing to pop. Consumer
+     only.
+     */
+    bool isEmpty() {
+        return this->head->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+    /*
+     Returns a string representation of this queue.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "MPSCQueue at " << this << std::endl;
+        if (this->isEmpty()) {
+            sout << "This queue is empty" << std::endl;
+        }
+        else {
+            sout << "Front data at " << this->peek() << std::endl;
+        }
+        return sout.str();
+    }
+
+};
@@ -0,0 +1,439 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "Pair.h"
+
+/*
+ A hash map from keys of type K to values of type V, using open addressing
+ with robin-hood probing: an entry being inserted takes the slot of any
+ entry that is closer to its home slot, so probe sequences stay short and
+ lookups take O(1) expected time even at high load. Removal shifts the
+ following entries back instead of leaving tombstones.
+
+ The map stores copies of its keys and values, so both must be default
+ constructible and copyable. Hash is any function object returning a
+ std::size_t for a key; the result is mixed before use, so hashes with
+ weak low bits (such as pointer addresses) are fine. Entries are presented
+ as Pairs pointing at the key and value stored in the map. Pointers to keys
+ and values, and iterators, stay valid until the next insertion, removal
+ or rehash.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>>
+class Map {
+
+protected:
+
+    /*
+     The map is grown before it gets fuller than this, as a fraction of its
+     capacity.
+     */
+    static const int maxLoadNumerator = 7;
+    static const int maxLoadDenominator = 8;
+
+    /*
+     Capacity of the first slot array a map allocates.
+     */
+    static const int initialCapacity = 8;
+
+    /*
+     A slot of the table. distance is one more than the number of slots the
+     entry sits past its home slot, or zero if the slot is empty.
+     */
+    struct Slot {
+        K key;
+        V value;
+        std::size_t hash;
+        int distance;
+
+        Slot() : key(), value() {
+            this->hash = 0;
+            this->distance = 0;
+        }
+    };
+
+    /*
+     The slots, their number (zero or a power of two), and the number of
+     entries.
+     */
+    Slot* slots;
+    int capacity;
+    int numEntries;
+
+    /*
+     The hash function.
+     */
+    Hash hasher;
+
+    /*
+     Returns the mixed hash of the specified key.
+     */
+    std::size_t hashOf(const K& key) const {
+        std::uint64_t h = static_cast<std::uint64_t>(this->hasher(key));
+        h *= 0x9E3779B97F4A7C15ull;
+        return static_cast<std::size_t>(h ^ (h >> 32));
+    }
+
+    /*
+     Returns the home slot of an entry with the specified hash.
+     */
+    int homeOf(std::size_t hash) const {
+        return static_cast<int>(hash & static_cast<std::size_t>(this->capacity - 1));
+    }
+
+    /*
+     Returns the index of the slot holding the specified key, or a negative
+     number if the key is not in this map.
+     */
+    int findSlot(const K& key) const {
+        if (this->numEntries == 0) {
+            return -1;
+        }
+        std::size_t hash = this->hashOf(key);
+        int index = this->homeOf(hash);
+        int distance = 1;
+        // an entry further from its home than the slot we are looking at
+        // would have displaced it, so we can stop at the first closer one
+        while (this->slots[index].distance >= distance) {
+            if (this->slots[index].hash == hash && this->slots[index].key == key) {
+                return index;
+            }
+            index = (index + 1) & (this->capacity - 1);
+            distance++;
+        }
+        return -1;
+    }
+
+    /*
+     Places an entry for a key that is not in this map, which must have a
+     free slot, and returns the index of its slot.
+     */
+    int placeNew(K key, V value, std::size_t hash) {
+        int index = this->homeOf(hash);
+        int distance = 1;
+        int result = -1;
+        while (true) {
+            Slot& slot = this->slots[index];
+            if (slot.distance == 0) {
+                slot.key = std::move(key);
+                slot.value = std::move(value);
+                slot.hash = hash;
+                slot.distance = distance;
+                this->numEntries++;
+                return result < 0 ? index : result;
+            }
+            if (slot.distance < distance) {
+                // rob the richer entry, and carry on placing it instead
+                std::swap(slot.key, key);
+                std::swap(slot.value, value);
+                std::swap(slot.hash, hash);
+                std::swap(slot.distance, distance);
+                if (result < 0) {
+                    result = index;
+                }
+            }
+            index = (index + 1) & (this->capacity - 1);
+            distance++;
+        }
+    }
+
+    /*
+     Moves every entry into a new slot array with the specified capacity,
+     which must be a power of two large enough for them.
+     */
+    void resize(int newCapacity) {
+        Slot* oldSlots = this->slots;
+        int oldCapacity = this->capacity;
+        this->slots = new Slot[newCapacity];
+        this->capacity = newCapacity;
+        this->numEntries = 0;
+        for (int k = 0; k < oldCapacity; k++) {
+            if (oldSlots[k].distance > 0) {
+                this->placeNew(std::move(oldSlots[k].key), std::move(oldSlots[k].value), oldSlots[k].hash);
+            }
+        }
+        delete[] oldSlots;
+    }
+
+    /*
+     Returns the smallest power-of-two capacity that holds the specified
+     number of entries within the maximum load.
+     */
+    static int capacityFor(int numEntries) {
+        int result = initialCapacity;
+        while (result * maxLoadNumerator < numEntries * maxLoadDenominator) {
+            result *= 2;
+        }
+        return result;
+    }
+
+public:
+
+    /*
+     A forward iterator over the entries of a map, in no particular order.
+     Dereferencing it yields a Pair pointing at the key and the value.
+     */
+    class Iterator {
+
+    protected:
+
+        Map<K, V, Hash>* map;
+        int index;
+
+        void skipEmpty() {
+            while (this->index < this->map->capacity && this->map->slots[this->index].distance == 0) {
+                this->index++;
+            }
+        }
+
+    public:
+
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Pair<K, V> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Pair<K, V>* pointer;
+        typedef Pair<K, V> reference;
+
+        Iterator(Map<K, V, Hash>* map, int index) {
+            this->map = map;
+            this->index = index;
+            this->skipEmpty();
+        }
+
+        Pair<K, V> operator*() const {
+            Slot& slot = this->map->slots[this->index];
+            return Pair<K, V>(&slot.key, &slot.value);
+        }
+
+        Iterator& operator++() {
+            this->index++;
+            this->skipEmpty();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator result = *this;
+            ++(*this);
+            return result;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return this->map == other.map && this->index == other.index;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
+        }
+
+    };
+
+    typedef Iterator iterator;
+
+    /*
+     Creates an empty map using the specified hash function. No slots are
+     allocated until the first insertion.
+     */
+    Map(Hash hasher = Hash()) : hasher(hasher) {
+        this->slots = nullptr;
+        this->capacity = 0;
+        this->numEntries = 0;
+    }
+
+    /*
+     Creates a map holding copies of the entries of the specified one.
+     */
+    Map(const Map<K, V, Hash>& other) : hasher(other.hasher) {
+        this->slots = nullptr;
+        this->capacity = other.capacity;
+        this->numEntries = other.numEntries;
+        if (other.capacity > 0) {
+            this->slots = new Slot[other.capacity];
+            for (int k = 0; k < other.capacity; k++) {
+                this->slots[k] = other.slots[k];
+            }
+        }
+    }
+
+    /*
+     Creates a map that takes over the entries of the specified one, leaving
+     it empty.
+     */
+    Map(Map<K, V, Hash>&& other) : hasher(other.hasher) {
+        this->slots = nullptr;
+        this->capacity = 0;
+        this->numEntries = 0;
+        this->swap(other);
+    }
+
+    /*
+     Replaces the entries of this map with copies of, or the entries of, the
+     specified map.
+     */
+    Map<K, V, Hash>& operator=(Map<K, V, Hash> other) {
+        this->swap(other);
+        return *this;
+    }
+
+    ~Map() {
+        delete[] this->slots;
+    }
+
+    /*
+     Exchanges the contents of this map and the specified one.
+     */
+    void swap(Map<K, V, Hash>& other) {
+        std::swap(this->slots, other.slots);
+        std::swap(this->capacity, other.capacity);
+        std::swap(this->numEntries, other.numEntries);
+        std::swap(this->hasher, other.hasher);
+    }
+
+    /*
+     Returns true if and only if this map has no entries.
+     */
+    bool isEmpty() {
+        return this->numEntries == 0;
+    }
+
+    /*
+     Returns the number of entries in this map.
+     */
+    int getSize() {
+        return this->numEntries;
+    }
+
+    /*
+     Returns the number of slots in this map.
+     */
+    int getCapacity() {
+        return this->capacity;
+    }
+
+    /*
+     Makes sure this map can hold the specified number of entries without
+     rehashing.
+     */
+    void reserve(int numEntries) {
+        int needed = capacityFor(numEntries);
+        if (needed > this->capacity) {
+            this->resize(needed);
+        }
+    }
+
+    /*
+     Rebuilds the table with at least the specified number of slots, and
+     enough for the current entries. Use it to shrink a map after many
+     removals, or to grow it ahead of time.
+     */
+    void rehash(int numSlots) {
+        int newCapacity = capacityFor(this->numEntries);
+        while (newCapacity < numSlots) {
+            newCapacity *= 2;
+        }
+        if (newCapacity != this->capacity) {
+            this->resize(newCapacity);
+        }
+    }
+
+    /*
+     Associates the specified value with the specified key, replacing any
+     value the key already had. Returns a pointer to the stored value.
+     */
+    V* put(const K& key, V value) {
+        int index = this->findSlot(key);
+        if (index >= 0) {
+            this->slots[index].value = std::move(value);
+        }
+        else {
+            if ((this->numEntries + 1) * maxLoadDenominator > this->capacity * maxLoadNumerator) {
+                this->resize(capacityFor(this->numEntries + 1));
+            }
+            index = this->placeNew(key, std::move(value), this->hashOf(key));
+        }
+        return &this->slots[index].value;
+    }
+
+    /*
+     Returns a pointer to the value associated with the specified key, or
+     the null pointer if the key is not in this map.
+     */
+    V* get(const K& key) {
+        int index = this->findSlot(key);
+        return index >= 0 ? &this->slots[index].value : nullptr;
+    }
+
+    /*
+     Returns true if and only if the specified key is in this map.
+     */
+    bool containsKey(const K& key) {
+        return this->findSlot(key) >= 0;
+    }
+
+    /*
+     Removes the entry for the specified key. Returns true if and only if
+     the key was in this map.
+     */
+    bool remove(const K& key) {
+        int index = this->findSlot(key);
+        if (index < 0) {
+            return false;
+        }
+        // shift the following entries back until one is at home
+        int next = (index + 1) & (this->capacity - 1);
+        while (this->slots[next].distance > 1) {
+            this->slots[index] = std::move(this->slots[next]);
+            this->slots[index].distance--;
+            index = next;
+            next = (next + 1) & (this->capacity - 1);
+        }
+        this->slots[index] = Slot();
+        this->numEntries--;
+        return true;
+    }
+
+    /*
+     Removes every entry from this map, keeping its slots.
+     */
+    void clear() {
+        for (int k = 0; k < this->capacity; k++) {
+            this->slots[k] = Slot();
+        }
+        this->numEntries = 0;
+    }
+
+    /*
+     Returns an iterator positioned at the first entry of this map.
+     */
+    Iterator begin() {
+        return Iterator(this, 0);
+    }
+
+    /*
+     Returns the past-the-end iterator of this map.
+     */
+    Iterator end() {
+        return Iterator(this, this->capacity);
+    }
+
+    /*
+     Returns a string representation of this map.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "Map at " << this << std::endl;
+        if (this->numEntries > 0) {
+            sout << "Map contains " << this->numEntries << " entries in " << this->capacity << " slots" << std::endl;
+        }
+        else {
+            sout << "This map is empty" << std::endl;
+        }
+        return sout.str();
+    }
+
+};
@@ -0,0 +1 @@
+#include "MapTester.h"
@@ -0,0 +1,406 @@
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "BTreeMap.h"
+#include "Map.h"
+#include "Pair.h"
+#include "TestResults.h"
+
+class MapTester {
+
+protected:
+
+    /*
+     A deliberately poor hash that sends every key to one of four values,
+     so that long probe sequences and backward shifts get exercised.
+     */
+    struct CollidingHash {
+        std::size_t operator()(int key) const {
+            return static_cast<std::size_t>(key % 4);
+        }
+    };
+
+    /*
+     Applies a pseudo-random sequence of puts and removals to the specified
+     map, mirroring each on an unordered_map, and checks every key in the
+     range after every step. Returns the number of disagreements.
+     */
+    template <typename MapType>
+    static int countModelMismatches(MapType* map, unsigned int seed, int numSteps, int keyRange) {
+        std::unordered_map<int, int> model;
+        int numMismatches = 0;
+        for (int step = 0; step < numSteps; step++) {
+            seed = seed * 1103515245 + 12345;
+            int key = static_cast<int>((seed >> 8) % keyRange);
+            if ((seed >> 20) % 3 == 0) {
+                bool removed = map->remove(key);
+                if (removed != (model.erase(key) > 0)) {
+                    numMismatches++;
+                }
+            }
+            else {
+                map->put(key, step);
+                model[key] = step;
+            }
+            if (map->getSize() != static_cast<int>(model.size())) {
+                numMismatches++;
+            }
+            for (int k = 0; k < keyRange; k++) {
+                int* value = map->get(k);
+                std::unordered_map<int, int>::iterator it = model.find(k);
+                if (it == model.end() ? value != nullptr : (value == nullptr || *value != it->second)) {
+                    numMismatches++;
+                }
+            }
+        }
+        return numMismatches;
+    }
+
+public:
+
+    /*
+     test put, get, containsKey and remove against a model, with a good
+     hash and with a colliding one
+     */
+    static TestResults* test0() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        // an empty map
+        pointsPossible++;
+        Map<int, int>* map = new Map<int, int>();
+        if (map->isEmpty() && map->get(3) == nullptr && !map->containsKey(3) && !map->remove(3)) {
+            pointsEarned++;
+        }
+        else {
+            sout << "an empty map reported an entry" << std::endl;
+        }
+        // random operations with the default hash
+        pointsPossible++;
+        int numMismatches = countModelMismatches(map, 11, 3000, 200);
+        if (numMismatches == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the map disagreed with the model " << numMismatches << " times" << std::endl;
+        }
+        delete map;
+        // random operations with a hash that collides constantly
+        pointsPossible++;
+        Map<int, int, CollidingHash>* collidingMap = new Map<int, int, CollidingHash>();
+        numMismatches = countModelMismatches(collidingMap, 23, 1500, 60);
+        if (numMismatches == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the colliding map disagreed with the model " << numMismatches << " times" << std::endl;
+        }
+        delete collidingMap;
+        std::cout << "MapTester::test0 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     test reserve, rehash, iteration over Pair entries, and copying
+     */
+    static TestResults* test1() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        Map<std::string, int>* map = new Map<std::string, int>();
+        // reserve makes room up front
+        pointsPossible++;
+        map->reserve(1000);
+        int capacity = map->getCapacity();
+        for (int k = 0; k < 1000; k++) {
+            map->put("key" + std::to_string(k), k);
+        }
+        if (map->getCapacity() == capacity && (capacity & (capacity - 1)) == 0 && map->getSize() == 1000) {
+            pointsEarned++;
+        }
+        else {
+            sout << "reserve(1000) did not prevent rehashing" << std::endl;
+        }
+        // put replaces the value of an existing key
+        pointsPossible++;
+        *map->put("key7", 0) += 70;
+        if (*map->get("key7") == 70 && map->getSize() == 1000) {
+            pointsEarned++;
+        }
+        else {
+            sout << "put did not replace an existing value" << std::endl;
+        }
+        // every entry is visited once, and points into the map
+        pointsPossible++;
+        long sum = 0;
+        int numVisited = 0;
+        bool pointsIntoMap = true;
+        for (Pair<std::string, int> entry : *map) {
+            sum += *entry.second;
+            numVisited++;
+            pointsIntoMap = pointsIntoMap && map->get(*entry.first) == entry.second;
+        }
+        if (numVisited == 1000 && sum == 999L * 1000 / 2 - 7 + 70 && pointsIntoMap) {
+            pointsEarned++;
+        }
+        else {
+            sout << "iteration visited " << numVisited << " entries with sum " << sum << std::endl;
+        }
+        // shrinking with rehash keeps every entry, and copies are independent
+        pointsPossible++;
+        for (int k = 100; k < 1000; k++) {
+            map->remove("key" + std::to_string(k));
+        }
+        map->rehash(0);
+        Map<std::string, int> copy(*map);
+        map->clear();
+        bool correct = map->isEmpty() && copy.getSize() == 100 && copy.getCapacity() < capacity;
+        for (int k = 0; k < 100 && correct; k++) {
+            correct = copy.containsKey("key" + std::to_string(k));
+        }
+        if (correct && !copy.containsKey("key100")) {
+            pointsEarned++;
+        }
+        else {
+            sout << "rehash or copying lost entries" << std::endl;
+        }
+        delete map;
+        std::cout << "MapTester::test1 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     test the B-tree map against a model, with nodes small enough that
+     splits, borrows and merges happen at every level, and check that
+     iteration stays in key order
+     */
+    static TestResults* test2() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        // an empty map
+        pointsPossible++;
+        BTreeMap<int, int, std::less<int>, 4>* map = new BTreeMap<int, int, std::less<int>, 4>();
+        if (map->isEmpty() && map->get(3) == nullptr && !map->remove(3) && map->begin() == map->end()) {
+            pointsEarned++;
+        }
+        else {
+            sout << "an empty B-tree map reported an entry" << std::endl;
+        }
+        // random operations
+        pointsPossible++;
+        int numMismatches = countModelMismatches(map, 17, 3000, 300);
+        if (numMismatches == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "the B-tree map disagreed with the model " << numMismatches << " times" << std::endl;
+        }
+        delete map;
+        // growing to several levels and shrinking back, iterating in order
+        pointsPossible++;
+        map = new BTreeMap<int, int, std::less<int>, 4>();
+        std::map<int, int> model;
+        unsigned int seed = 5;
+        for (int k = 0; k < 2000; k++) {
+            seed = seed * 1103515245 + 12345;
+            int key = static_cast<int>((seed >> 8) % 5000);
+            map->put(key, k);
+            model[key] = k;
+        }
+        int height = map->getHeight();
+        bool inOrder = true;
+        std::map<int, int>::iterator it = model.begin();
+        for (Pair<int, int> entry : *map) {
+            inOrder = inOrder && it != model.end() && *entry.first == it->first && *entry.second == it->second;
+            ++it;
+        }
+        inOrder = inOrder && it == model.end();
+        for (std::map<int, int>::iterator removed = model.begin(); removed != model.end(); ++removed) {
+            inOrder = map->remove(removed->first) && inOrder;
+        }
+        if (inOrder && height >= 5 && map->isEmpty() && map->getHeight() == 1) {
+            pointsEarned++;
+        }
+        else {
+            sout << "iteration or removal went wrong in a tree of height " << height << std::endl;
+        }
+        delete map;
+        std::cout << "MapTester::test2 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     test lowerBound, upperBound and getRange, and copying a B-tree map
+     */
+    static TestResults* test3() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        // scores 0, 10, 20, ..., 990 mapped to their rank
+        BTreeMap<int, std::string, std::less<int>, 8>* map = new BTreeMap<int, std::string, std::less<int>, 8>();
+        for (int k = 99; k >= 0; k--) {
+            map->put(k * 10, "player" + std::to_string(k));
+        }
+        // bounds between keys, on keys, and past either end
+        pointsPossible++;
+        bool correct = *(*map->lowerBound(25)).first == 30 && *(*map->upperBound(25)).first == 30;
+        correct = correct && *(*map->lowerBound(30)).first == 30 && *(*map->upperBound(30)).first == 40;
+        correct = correct && *(*map->lowerBound(-5)).first == 0 && *(*map->lowerBound(985)).second == "player99";
+        correct = correct && map->lowerBound(991) == map->end() && map->upperBound(990) == map->end();
+        if (correct) {
+            pointsEarned++;
+        }
+        else {
+            sout << "lowerBound or upperBound found the wrong entry" << std::endl;
+        }
+        // a range includes its low end and excludes its high end
+        pointsPossible++;
+        int numVisited = 0;
+        int sum = 0;
+        for (Pair<int, std::string> entry : map->getRange(100, 200)) {
+            numVisited++;
+            sum += *entry.first;
+        }
+        int numEmpty = 0;
+        for (Pair<int, std::string> entry : map->getRange(200, 100)) {
+            numEmpty += entry.first != nullptr ? 1 : 0;
+        }
+        if (numVisited == 10 && sum == 1450 && numEmpty == 0) {
+            pointsEarned++;
+        }
+        else {
+            sout << "getRange(100, 200) visited " << numVisited << " entries" << std::endl;
+        }
+        // a range still works after removals thin out the leaves
+        pointsPossible++;
+        for (int k = 0; k < 100; k++) {
+            if (k % 3 != 0) {
+                map->remove(k * 10);
+            }
+        }
+        numVisited = 0;
+        for (Pair<int, std::string> entry : map->getRange(0, 1000)) {
+            numVisited += *entry.first % 30 == 0 ? 1 : 100;
+        }
+        if (numVisited == 34 && map->getSize() == 34) {
+            pointsEarned++;
+        }
+        else {
+            sout << "after removals a full range gave " << numVisited << std::endl;
+        }
+        // copies are independent of the original
+        pointsPossible++;
+        BTreeMap<int, std::string, std::less<int>, 8> copy(*map);
+        map->clear();
+        if (map->isEmpty() && copy.getSize() == 34 && *copy.get(990) == "player99" && copy.get(10) == nullptr) {
+            pointsEarned++;
+        }
+        else {
+            sout << "a copied B-tree map lost entries" << std::endl;
+        }
+        delete map;
+        std::cout << "MapTester::test3 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    /*
+     test Pair as a value: copying, comparison, ordering, and use as a key
+     of Map and of the standard unordered containers
+     */
+    static TestResults* test4() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+        static_assert(std::is_trivially_copyable<Pair<int, std::string>>::value, "Pair must be trivially copyable");
+        static_assert(Pair<int, int>().isEmpty() && !Pair<int, int>().isComplete(), "Pair must be usable in constant expressions");
+        static_assert(Pair<int, int>() == Pair<int, int>(nullptr, nullptr), "Pair must compare in constant expressions");
+        int* values = new int[50];
+        // equality looks at both elements, and ordering is lexicographic
+        pointsPossible++;
+        Pair<int, int> a(&values[1], &values[2]);
+        Pair<int, int> b(&values[1], &values[3]);
+        Pair<int, int> c(&values[2], &values[0]);
+        Pair<int, int> copy = a;
+        bool correct = copy == a && a != b && !(a == b) && a < b && b < c && a < c && !(c < a);
+        correct = correct && c > b && a <= copy && a >= copy && b >= a && a.swap().swap() == a;
+        if (correct) {
+            pointsEarned++;
+        }
+        else {
+            sout << "Pair comparison or ordering was wrong" << std::endl;
+        }
+        // every pair of 50 x 50 pointers is a distinct key
+        pointsPossible++;
+        Map<Pair<int, int>, int> map;
+        std::unordered_set<Pair<int, int>> set;
+        for (int i = 0; i < 50; i++) {
+            for (int j = 0; j < 50; j++) {
+                map.put(Pair<int, int>(&values[i], &values[j]), i * 50 + j);
+                set.insert(Pair<int, int>(&values[i], &values[j]));
+            }
+        }
+        correct = map.getSize() == 2500 && set.size() == 2500 && *map.get(b) == 53 && set.count(c) == 1;
+        if (correct && map.get(Pair<int, int>(&values[1], nullptr)) == nullptr) {
+            pointsEarned++;
+        }
+        else {
+            sout << "Pairs did not work as hash keys" << std::endl;
+        }
+        delete[] values;
+        std::cout << "MapTester::test4 results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    static TestResults* testX() {
+        std::ostringstream sout;
+        int pointsPossible = 0;
+        int pointsEarned = 0;
+
+        std::cout << "MapTester::testX results:" << std::endl;
+        return new TestResults(pointsPossible, pointsEarned, sout.str());
+    }
+
+    static TestResults* runAllTests() {
+        int totalPossible = 0;
+        int totalEarned = 0;
+
+        TestResults* r;
+
+        r = test0();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test1();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test2();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test3();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        r = test4();
+        totalPossible += r->pointsPossible;
+        totalEarned += r->pointsEarned;
+        std::cout << r->toString() << std::endl;
+
+        return new TestResults(totalPossible, totalEarned, "");
+    }
+
+};
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <utility>
+
+/*
+ Counts the allocations the node allocators request from the system
+ allocator, so the effect of switching allocators on a workload can be
+ measured: read the count before and after running the workload. The
+ count is atomic, since any thread may allocate.
+ */
+class SystemAllocationCounter {
+
+protected:
+
+    static std::atomic<long>& counter() {
+        static std::atomic<long> count(0);
+        return count;
+    }
+
+public:
+
+    /*
+     Returns the number of system allocations made so far.
+     */
+    static long getCount() {
+        return counter();
+    }
+
+    /*
+     Records one system allocation.
+     */
+    static void recordAllocation() {
+        counter()++;
+    }
+
+};
+
+/*
+ A slab pool for objects of type N. Memory is obtained from the system in
+ cache-line-aligned blocks holding many objects, and freed objects are kept
+ on a free list and handed out again before any new block is requested.
+
+ There is one pool per type, shared by every container that allocates that
+ type, so unlike a single container it is used from many threads at once:
+ a list built on one thread can be freed on another, while other threads
+ build lists of their own. Every operation therefore takes the pool's
+ lock. Blocks are never returned to the system, since containers with
+ static storage duration may still release nodes while the program exits.
+ */
+template <typename N>
+class NodePool {
+
+protected:
+
+    /*
+     Size of a cache line, and the default size of a block, in bytes.
+     */
+    static const std::size_t cacheLineSize = 64;
+    static const std::size_t defaultBlockSize = 4096;
+
+    /*
+     Free slots are linked through their first word.
+     */
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    /*
+     Size of a slot: big enough for an N or a FreeSlot, and a multiple of
+     the alignment of N.
+     */
+    static std::size_t slotSize() {
+        std::size_t size = sizeof(N) > sizeof(FreeSlot) ? sizeof(N) : sizeof(FreeSlot);
+        std::size_t alignment = alignof(N) > alignof(FreeSlot) ? alignof(N) : alignof(FreeSlot);
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    /*
+     The head of the free list.
+     */
+    FreeSlot* freeList;
+
+    /*
+     The unused tail of the most recent block: slots in [nextSlot, blockEnd)
+     have never been handed out.
+     */
+    unsigned char* nextSlot;
+    unsigned char* blockEnd;
+
+    /*
+     Number of blocks obtained, and number of slots currently handed out.
+     */
+    long numBlocks;
+    long numInUse;
+
+    /*
+     Guards every member above.
+     */
+    std::mutex lock;
+
+    NodePool() {
+        this->freeList = nullptr;
+        this->nextSlot = nullptr;
+        this->blockEnd = nullptr;
+        this->numBlocks = 0;
+        this->numInUse = 0;
+    }
+
+    /*
+     Obtains a new cache-line-aligned block with room for the specified
+     number of slots, which becomes the unused tail.
+     */
+    void allocateBlock(std::size_t numSlots) {
+        std::size_t bytes = numSlots * slotSize();
+        unsigned char* raw = static_cast<unsigned char*>(::operator new(bytes + cacheLineSize - 1));
+        SystemAllocationCounter::recordAllocation();
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(raw);
+        std::uintptr_t aligned = (address + cacheLineSize - 1) / cacheLineSize * cacheLineSize;
+        // whatever is left of the previous block goes on the free list
+        while (this->nextSlot != this->blockEnd) {
+            this->push(this->nextSlot);
+            this->nextSlot += slotSize();
+        }
+        this->nextSlot = raw + (aligned - address);
+        this->blockEnd = this->nextSlot + bytes;
+        this->numBlocks++;
+    }
+
+    /*
+     Puts the specified slot on the free list.
+     */
+    void push(void* slot) {
+        FreeSlot* freeSlot = static_cast<FreeSlot*>(slot);
+        freeSlot->next = this->freeList;
+        this->freeList = freeSlot;
+    }
+
+public:
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    /*
+     Returns the pool for type N.
+     */
+    static NodePool<N>& getInstance() {
+        static NodePool<N> instance;
+        return instance;
+    }
+
+    /*
+     Returns uninitialized storage for one N.
+     */
+    void* allocate() {
+        std::lock_guard<std::mutex> guard(this->lock);
+        void* result;
+        if (this->freeList != nullptr) {
+            result = this->freeList;
+            this->freeList = this->freeList->next;
+        }
+        else {
+            if (this->nextSlot == this->blockEnd) {
+                std::size_t numSlots = defaultBlockSize / slotSize();
+                this->allocateBlock(numSlots > 0 ? numSlots : 1);
+            }
+            result = this->nextSlot;
+            this->nextSlot += slotSize();
+        }
+        this->numInUse++;
+        return result;
+    }
+
+    /*
+     Returns storage obtained from allocate to the pool.
+     */
+    void release(void* slot) {
+        std::lock_guard<std::mutex> guard(this->lock);
+        this->push(slot);
+        this->numInUse--;
+    }
+
+    /*
+     Makes sure the next numSlots allocations can be served without going
+     back to the system, using at most one new block.
+     */
+    void reserve(int numSlots) {
+        std::lock_guard<std::mutex> guard(this->lock);
+        long available = static_cast<long>((this->blockEnd - this->nextSlot) / slotSize());
+        for (FreeSlot* slot = this->freeList; slot != nullptr && available < numSlots; slot = slot->next) {
+            available++;
+        }
+        if (available < numSlots) {
+            this->allocateBlock(static_cast<std::size_t>(numSlots));
+        }
+    }
+
+    /*
+     Returns the number of blocks this pool has obtained from the system.
+     */
+    long getNumBlocks() {
+        std::lock_guard<std::mutex> guard(this->lock);
+        return this->numBlocks;
+    }
+
+    /*
+     Returns the number of objects currently allocated from this pool.
+     */
+    long getNumInUse() {
+        std::lock_guard<std::mutex> guard(this->lock);
+        return this->numInUse;
+    }
+
+};
+
+/*
+ Node allocation policy that takes nodes from the per-type NodePool. This
+ is the default policy for Chain and List.
+ */
+struct PooledNodeAllocator {
+
+    template <typename N, typename... Args>
+    static N* create(Args&&... args) {
+        void* slot = NodePool<N>::getInstance().allocate();
+        return new (slot) N(std::forward<Args>(args)...);
+    }
+
+    template <typename N>
+    static void destroy(N* node) {
+        node->~N();
+        NodePool<N>::getInstance().release(node);
+    }
+
+    template <typename N>
+    static void reserve(int numNodes) {
+        NodePool<N>::getInstance().reserve(numNodes);
+    }
+
+};
+
+/*
+ Node allocation policy that allocates every node individually with new
+ and frees it with delete.
+ */
+struct HeapNodeAllocator {
+
+    template <typename N, typename... Args>
+    static N* create(Args&&... args) {
+        SystemAllocationCounter::recordAllocation();
+        return new N(std::forward<Args>(args)...);
+    }
+
+    template <typename N>
+    static void destroy(N* node) {
+        delete node;
+    }
+
+    template <typename N>
+    static void reserve(int numNodes) {}
+
+};
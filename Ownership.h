@@ -0,0 +1,19 @@
+#pragma once
+
+/*
+ Says whether a container deletes the data its elements point to.
+
+ Containers never own data by default: lists, vertices and edges hold
+ pointers to data that the caller allocated and is responsible for
+ freeing. They do own their own structure (nodes, chunks, adjacency
+ lists), and release it when they are destroyed.
+
+ A Graph created with DataOwnership::Owned takes ownership of the data
+ stored in its vertices and edges: it deletes that data when it is
+ destroyed, and deletes the old data when it is replaced. Owned data must
+ be stored in only one vertex or edge.
+ */
+enum class DataOwnership {
+    Borrowed,
+    Owned
+};
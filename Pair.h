@@ -1,6 +1,7 @@
 #pragma once
 
-#include <iostream>
+#include <cstddef>
+#include <functional>
 #include <sstream>
 #include <string>
 
@@ -8,6 +9,12 @@
  A class to represent paired data. A Pair has a first element and
  a second element. These attributes are publicly accessible, and
  the types of the first and second element can be arbitrary.
+
+ A Pair is a small value: it holds two pointers, is trivially copyable,
+ and can be built and compared in constant expressions. Pairs compare
+ equal when both pointers are equal, are ordered by their first pointer
+ and then their second, and can be hashed, so they work as keys of Map
+ and of the standard containers.
  */
 template <typename T, typename U>
 class Pair {
@@ -23,44 +30,38 @@ public:
     /*
      Creates an empty pair.
      */
-    Pair() {
-        this->first = nullptr;
-        this->second = nullptr;
-    }
+    constexpr Pair() : first(nullptr), second(nullptr) {}
 
     /*
      Creates a pair whose first and second elements are the specified data.
      */
-    Pair(T* first, U* second) {
-        this->first = first;
-        this->second = second;
-    }
+    constexpr Pair(T* first, U* second) : first(first), second(second) {}
 
     /*
      Returns true if and only if both elements of this pair are null.
      */
-    bool isEmpty() {
+    constexpr bool isEmpty() const {
         return (this->first == nullptr && this->second == nullptr);
     }
 
     /*
      Returns true if and only if both elements of this pair are non-null.
      */
-    bool isComplete() {
+    constexpr bool isComplete() const {
         return (this->first != nullptr && this->second != nullptr);
     }
 
     /*
-     Swaps the elements of the pair.
+     Returns a pair with the elements of this one swapped.
      */
-    Pair<U, T>* swap() {
-        return new Pair<U, T>(this->second, this->first);
+    constexpr Pair<U, T> swap() const {
+        return Pair<U, T>(this->second, this->first);
     }
 
     /*
      Returns a string representation of this pair
      */
-    std::string toString() {
+    std::string toString() const {
         std::ostringstream sout;
         sout << "Pair at " << this << std::endl;
         if (this->first != nullptr) {
@@ -78,16 +79,6 @@ public:
         return sout.str();
     }
 
-    /*
-     Overload operator== to compare the pair to another one. This will
-     return true if and only if this->first and rhs.first both point to the
-     same data item AND this->second and rhs.second both point to the
-     same data item.
-     */
-     //    bool operator==(Pair<T,U> const &rhs) {
-     //        return (this->first == rhs.first && this->second == rhs.second);
-     //    }
-
 };
 
 /*
@@ -97,7 +88,51 @@ public:
  same data item.
  */
 template <typename T, typename U>
-bool operator==(Pair<T, U>& lhs, Pair<T, U>& rhs) {
-    std::cout << "operator== here" << std::endl;
-    return (lhs.first == rhs.first && lhs.first == rhs.first);
+constexpr bool operator==(const Pair<T, U>& lhs, const Pair<T, U>& rhs) {
+    return (lhs.first == rhs.first && lhs.second == rhs.second);
+}
+
+template <typename T, typename U>
+constexpr bool operator!=(const Pair<T, U>& lhs, const Pair<T, U>& rhs) {
+    return !(lhs == rhs);
+}
+
+/*
+ Orders Pairs by the address in first, then by the address in second.
+ std::less gives a total order even over pointers into different objects.
+ */
+template <typename T, typename U>
+constexpr bool operator<(const Pair<T, U>& lhs, const Pair<T, U>& rhs) {
+    return std::less<T*>()(lhs.first, rhs.first)
+        || (lhs.first == rhs.first && std::less<U*>()(lhs.second, rhs.second));
+}
+
+template <typename T, typename U>
+constexpr bool operator>(const Pair<T, U>& lhs, const Pair<T, U>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename T, typename U>
+constexpr bool operator<=(const Pair<T, U>& lhs, const Pair<T, U>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename T, typename U>
+constexpr bool operator>=(const Pair<T, U>& lhs, const Pair<T, U>& rhs) {
+    return !(lhs < rhs);
+}
+
+namespace std {
+
+    /*
+     Hashes a Pair by combining the hashes of its two pointers.
+     */
+    template <typename T, typename U>
+    struct hash<Pair<T, U>> {
+        std::size_t operator()(const Pair<T, U>& pair) const {
+            std::size_t h = std::hash<T*>()(pair.first);
+            return h ^ (std::hash<U*>()(pair.second) + static_cast<std::size_t>(0x9E3779B97F4A7C15ull) + (h << 6) + (h >> 2));
+        }
+    };
+
 }
@@ -8,14 +8,15 @@ Paladin::Paladin() {
 	this->characterName = "Unnamed character";
 	this->characterAge = 0;
 	this->characterDesc = "No description available.";
-	// create the list of player actions that a Paladin is capable of
-	this->playerActions = new List<PlayerActions>();
-	this->playerActions->insertAtEnd(new PlayerActions(PlayerActions::PlayerAction::Fight));
-	this->playerActions->insertAtEnd(new PlayerActions(PlayerActions::PlayerAction::SwordFight));
-	this->playerActions->insertAtEnd(new PlayerActions(PlayerActions::PlayerAction::CastSpell));
-	this->playerActions->insertAtEnd(new PlayerActions(PlayerActions::PlayerAction::RideHorse));
-	this->playerActions->insertAtEnd(new PlayerActions(PlayerActions::PlayerAction::PutOnArmor));
-	this->playerActions->insertAtEnd(new PlayerActions(PlayerActions::PlayerAction::TakeOffArmor));
+	// replace the generic player actions with those a Paladin is capable of
+	this->playerActions->assign({
+		PlayerActions(PlayerActions::PlayerAction::Fight),
+		PlayerActions(PlayerActions::PlayerAction::SwordFight),
+		PlayerActions(PlayerActions::PlayerAction::CastSpell),
+		PlayerActions(PlayerActions::PlayerAction::RideHorse),
+		PlayerActions(PlayerActions::PlayerAction::PutOnArmor),
+		PlayerActions(PlayerActions::PlayerAction::TakeOffArmor)
+	});
 }
 
 // second constructor
@@ -24,14 +25,15 @@ Paladin::Paladin(std::string playerName, std::string characterName, int characte
 	this->characterName = characterName;
 	this->characterAge = characterAge;
 	this->characterDesc = "No description available.";
-	// create the list of player actions that a Paladin is capable of
-	this->playerActions = new List<PlayerActions>();
-	this->playerActions->insertAtEnd(new PlayerActions(PlayerActions::PlayerAction::Fight));
-	this->playerActions->insertAtEnd(new PlayerActions(PlayerActions::PlayerAction::SwordFight));
-	this->playerActions->insertAtEnd(new PlayerActions(PlayerActions::PlayerAction::CastSpell));
-	this->playerActions->insertAtEnd(new PlayerActions(PlayerActions::PlayerAction::RideHorse));
-	this->playerActions->insertAtEnd(new PlayerActions(PlayerActions::PlayerAction::PutOnArmor));
-	this->playerActions->insertAtEnd(new PlayerActions(PlayerActions::PlayerAction::TakeOffArmor));
+	// replace the generic player actions with those a Paladin is capable of
+	this->playerActions->assign({
+		PlayerActions(PlayerActions::PlayerAction::Fight),
+		PlayerActions(PlayerActions::PlayerAction::SwordFight),
+		PlayerActions(PlayerActions::PlayerAction::CastSpell),
+		PlayerActions(PlayerActions::PlayerAction::RideHorse),
+		PlayerActions(PlayerActions::PlayerAction::PutOnArmor),
+		PlayerActions(PlayerActions::PlayerAction::TakeOffArmor)
+	});
 }
 
 CharacterTypes Paladin::getCharacterType() {
@@ -39,15 +41,14 @@ CharacterTypes Paladin::getCharacterType() {
 	return *result;
 }
 
-List<PlayerActions>* Paladin::getPlayerActions() {
+ValueList<PlayerActions>* Paladin::getPlayerActions() {
 	return this->playerActions;
 }
 
 bool Paladin::canPerformAction(PlayerActions anAction) {
 	bool result = false;
-	for (int k = 0; k < this->playerActions->getSize(); k++) {
-		PlayerActions* actionK = this->playerActions->peek(k);
-		if (anAction == *actionK) {
+	for (PlayerActions& actionK : *this->playerActions) {
+		if (anAction == actionK) {
 			result = true;
 			break;
 		}
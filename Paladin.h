@@ -2,7 +2,7 @@
 
 #include "Player.h"
 #include "PlayerActions.h"
-#include "List.h"
+#include "ValueList.h"
 #include "CharacterTypes.h"
 
 class Paladin : public Player {
@@ -28,7 +28,7 @@ public:
     /*
     Returns a list of actions this character is capable of.
     */
-    List<PlayerActions>* getPlayerActions() override;
+    ValueList<PlayerActions>* getPlayerActions() override;
 
     /*
     Returns true if and only if this player can perform the specified action.
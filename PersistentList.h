@@ -0,0 +1,458 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ A persistent list of data pointers: copying it, or taking a snapshot,
+ takes O(1) time, and the copies share all of their structure until one of
+ them changes. The elements are kept in a balanced (AVL) tree ordered by
+ position, whose nodes are never modified once built. An update copies
+ only the O(log n) nodes on the path to the changed position, so every
+ other copy keeps seeing its own version.
+
+ It has the same interface as List for reading (peek, getIndex, getSize,
+ isEmpty, iteration, toString) and for positional updates. peek and every
+ update take O(log n) time. Like the other lists, it holds pointers to
+ data it does not own, and snapshots share those pointers.
+
+ Nodes are reference counted with shared_ptr, so a snapshot may be read
+ on another thread while the list it came from keeps changing.
+ */
+template <typename T>
+class PersistentList {
+
+protected:
+
+    struct TreeNode;
+
+    typedef std::shared_ptr<const TreeNode> NodePointer;
+
+    /*
+     An immutable tree node: its data, its subtrees, the number of elements
+     in the subtree it roots, and the height of that subtree.
+     */
+    struct TreeNode {
+        T* data;
+        NodePointer left;
+        NodePointer right;
+        int size;
+        int height;
+
+        TreeNode(T* data, NodePointer left, NodePointer right) : left(left), right(right) {
+            this->data = data;
+            this->size = sizeOf(left) + sizeOf(right) + 1;
+            int leftHeight = heightOf(left);
+            int rightHeight = heightOf(right);
+            this->height = (leftHeight > rightHeight ? leftHeight : rightHeight) + 1;
+        }
+    };
+
+    /*
+     The root of the tree, or the null pointer if this list is empty.
+     */
+    NodePointer root;
+
+    static int sizeOf(const NodePointer& node) {
+        return node == nullptr ? 0 : node->size;
+    }
+
+    static int heightOf(const NodePointer& node) {
+        return node == nullptr ? 0 : node->height;
+    }
+
+    static NodePointer makeNode(T* data, const NodePointer& left, const NodePointer& right) {
+        return std::make_shared<const TreeNode>(data, left, right);
+    }
+
+    /*
+     Returns a tree with the specified data between the specified subtrees,
+     whose heights differ by at most two, rotating it back into balance if
+     needed.
+     */
+    static NodePointer balance(T* data, const NodePointer& left, const NodePointer& right) {
+        int leftHeight = heightOf(left);
+        int rightHeight = heightOf(right);
+        if (leftHeight > rightHeight + 1) {
+            if (heightOf(left->left) >= heightOf(left->right)) {
+                // single right rotation
+                return makeNode(left->data, left->left, makeNode(data, left->right, right));
+            }
+            // left-right double rotation
+            const NodePointer& middle = left->right;
+            return makeNode(middle->data, makeNode(left->data, left->left, middle->left), makeNode(data, middle->right, right));
+        }
+        if (rightHeight > leftHeight + 1) {
+            if (heightOf(right->right) >= heightOf(right->left)) {
+                // single left rotation
+                return makeNode(right->data, makeNode(data, left, right->left), right->right);
+            }
+            // right-left double rotation
+            const NodePointer& middle = right->left;
+            return makeNode(middle->data, makeNode(data, left, middle->left), makeNode(right->data, middle->right, right->right));
+        }
+        return makeNode(data, left, right);
+    }
+
+    /*
+     Returns a copy of the specified tree with the specified data inserted
+     at the specified position, which must be between 0 and the size of the
+     tree.
+     */
+    static NodePointer insertAt(const NodePointer& node, int position, T* data) {
+        if (node == nullptr) {
+            return makeNode(data, nullptr, nullptr);
+        }
+        int leftSize = sizeOf(node->left);
+        if (position <= leftSize) {
+            return balance(node->data, insertAt(node->left, position, data), node->right);
+        }
+        return balance(node->data, node->left, insertAt(node->right, position - leftSize - 1, data));
+    }
+
+    /*
+     Returns a copy of the specified tree without its first element, and
+     sets removed to that element's data.
+     */
+    static NodePointer removeFirst(const NodePointer& node, T*& removed) {
+        if (node->left == nullptr) {
+            removed = node->data;
+            return node->right;
+        }
+        return balance(node->data, removeFirst(node->left, removed), node->right);
+    }
+
+    /*
+     Returns a copy of the specified tree without the element at the
+     specified position, which must exist, and sets removed to its data.
+     */
+    static NodePointer removeAt(const NodePointer& node, int position, T*& removed) {
+        int leftSize = sizeOf(node->left);
+        if (position < leftSize) {
+            return balance(node->data, removeAt(node->left, position, removed), node->right);
+        }
+        if (position > leftSize) {
+            return balance(node->data, node->left, removeAt(node->right, position - leftSize - 1, removed));
+        }
+        removed = node->data;
+        if (node->left == nullptr) {
+            return node->right;
+        }
+        if (node->right == nullptr) {
+            return node->left;
+        }
+        // the next element takes this node's place
+        T* successor;
+        NodePointer right = removeFirst(node->right, successor);
+        return balance(successor, node->left, right);
+    }
+
+    /*
+     Returns a copy of the specified tree with the data at the specified
+     position, which must exist, replaced.
+     */
+    static NodePointer setAt(const NodePointer& node, int position, T* data) {
+        int leftSize = sizeOf(node->left);
+        if (position < leftSize) {
+            return makeNode(node->data, setAt(node->left, position, data), node->right);
+        }
+        if (position > leftSize) {
+            return makeNode(node->data, node->left, setAt(node->right, position - leftSize - 1, data));
+        }
+        return makeNode(data, node->left, node->right);
+    }
+
+    /*
+     Builds a perfectly balanced tree from the data pointers in the range
+     [first, last) of the specified array.
+     */
+    static NodePointer build(T** items, int first, int last) {
+        if (first >= last) {
+            return nullptr;
+        }
+        int middle = first + (last - first) / 2;
+        return makeNode(items[middle], build(items, first, middle), build(items, middle + 1, last));
+    }
+
+public:
+
+    /*
+     A forward iterator over the elements of a persistent list, in order.
+     It keeps the path from the root to its node, and holds on to the
+     version of the list it was created from.
+     */
+    class Iterator {
+
+    protected:
+
+        NodePointer root;
+        std::vector<const TreeNode*> path;
+
+        void descendLeft(const TreeNode* node) {
+            while (node != nullptr) {
+                this->path.push_back(node);
+                node = node->left.get();
+            }
+        }
+
+    public:
+
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef T** pointer;
+        typedef T* reference;
+
+        /*
+         Creates an iterator positioned at the first element of the
+         specified tree, or the past-the-end iterator if atEnd is true.
+         */
+        Iterator(NodePointer root, bool atEnd) : root(root) {
+            if (!atEnd) {
+                this->descendLeft(root.get());
+            }
+        }
+
+        T* operator*() const {
+            return this->path.back()->data;
+        }
+
+        Iterator& operator++() {
+            const TreeNode* node = this->path.back();
+            this->path.pop_back();
+            this->descendLeft(node->right.get());
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator result = *this;
+            ++(*this);
+            return result;
+        }
+
+        bool operator==(const Iterator& other) const {
+            const TreeNode* node = this->path.empty() ? nullptr : this->path.back();
+            const TreeNode* otherNode = other.path.empty() ? nullptr : other.path.back();
+            return node == otherNode;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
+        }
+
+    };
+
+    typedef Iterator iterator;
+
+    /*
+     Creates an empty list.
+     */
+    PersistentList() {}
+
+    /*
+     Creates a list with the specified data pointers, in order.
+     */
+    PersistentList(std::initializer_list<T*> items) : PersistentList(items.begin(), items.end()) {}
+
+    /*
+     Creates a list with the data pointers in the range [first, last), in
+     order, such as those of another list.
+     */
+    template <typename InputIterator>
+    PersistentList(InputIterator first, InputIterator last) {
+        std::vector<T*> items(first, last);
+        this->root = build(items.data(), 0, static_cast<int>(items.size()));
+    }
+
+    /*
+     Copying a persistent list takes O(1) time: the copy shares every node
+     with the original.
+     */
+    PersistentList(const PersistentList<T>& other) = default;
+    PersistentList(PersistentList<T>&& other) = default;
+    PersistentList<T>& operator=(const PersistentList<T>& other) = default;
+    PersistentList<T>& operator=(PersistentList<T>&& other) = default;
+
+    /*
+     Returns a copy of the current version of this list, in O(1) time.
+     Later changes to either list don't affect the other.
+     */
+    PersistentList<T> snapshot() const {
+        return *this;
+    }
+
+    /*
+     Returns true if and only if the specified list is a snapshot of this
+     version of this list, so they share every node.
+     */
+    bool isSameVersion(const PersistentList<T>& other) const {
+        return this->root == other.root;
+    }
+
+    /*
+     Removes every element from this list. Snapshots keep theirs.
+     */
+    void clear() {
+        this->root.reset();
+    }
+
+    /*
+     Returns true if and only if this list has no elements.
+     */
+    bool isEmpty() {
+        return this->root == nullptr;
+    }
+
+    /*
+     Returns the number of elements in this list.
+     */
+    int getSize() {
+        return sizeOf(this->root);
+    }
+
+    /*
+     Returns the data at the specified position, or the null pointer if the
+     position does not exist in this list.
+     */
+    T* peek(int position) {
+        T* result = nullptr;
+        if (position >= 0 && position < this->getSize()) {
+            const TreeNode* node = this->root.get();
+            int leftSize = sizeOf(node->left);
+            while (position != leftSize) {
+                if (position < leftSize) {
+                    node = node->left.get();
+                }
+                else {
+                    position -= leftSize + 1;
+                    node = node->right.get();
+                }
+                leftSize = sizeOf(node->left);
+            }
+            result = node->data;
+        }
+        return result;
+    }
+
+    /*
+     Replaces the data at the specified position. If the position does not
+     exist in this list, this method does nothing.
+     */
+    void setData(T* data, int position) {
+        if (position >= 0 && position < this->getSize()) {
+            this->root = setAt(this->root, position, data);
+        }
+    }
+
+    /*
+     Inserts the specified data at the start of this list.
+     */
+    void insertAtStart(T* data) {
+        this->root = insertAt(this->root, 0, data);
+    }
+
+    /*
+     Inserts the specified data at the end of this list.
+     */
+    void insertAtEnd(T* data) {
+        this->root = insertAt(this->root, this->getSize(), data);
+    }
+
+    /*
+     Inserts the specified data at the specified position. A position at or
+     before the start inserts at the start, and one at or past the end
+     inserts at the end.
+     */
+    void insertAtPosition(int position, T* data) {
+        if (position < 0) {
+            position = 0;
+        }
+        if (position > this->getSize()) {
+            position = this->getSize();
+        }
+        this->root = insertAt(this->root, position, data);
+    }
+
+    /*
+     Removes the element at the specified position and returns its data. If
+     there is no element in the specified position, this method leaves the
+     list unaltered and returns the null pointer.
+     */
+    T* removeFromPosition(int position) {
+        T* result = nullptr;
+        if (position >= 0 && position < this->getSize()) {
+            this->root = removeAt(this->root, position, result);
+        }
+        return result;
+    }
+
+    /*
+     Removes the first element and returns its data, or returns the null
+     pointer if this list is empty.
+     */
+    T* removeFromStart() {
+        return this->removeFromPosition(0);
+    }
+
+    /*
+     Removes the last element and returns its data, or returns the null
+     pointer if this list is empty.
+     */
+    T* removeFromEnd() {
+        return this->removeFromPosition(this->getSize() - 1);
+    }
+
+    /*
+     Returns the position of the first occurrence of the specified data
+     pointer in this list, or a negative number if it is not in this list.
+     This scans the list.
+     */
+    int getIndex(T* data) {
+        int result = -1;
+        int k = 0;
+        for (T* item : *this) {
+            if (item == data) {
+                result = k;
+                break;
+            }
+            k++;
+        }
+        return result;
+    }
+
+    /*
+     Returns an iterator positioned at the first element of this list.
+     */
+    Iterator begin() const {
+        return Iterator(this->root, false);
+    }
+
+    /*
+     Returns the past-the-end iterator of this list.
+     */
+    Iterator end() const {
+        return Iterator(this->root, true);
+    }
+
+    /*
+     Returns a string representation of this list.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "PersistentList at " << this << std::endl;
+        if (this->root != nullptr) {
+            sout << "List contains " << this->getSize() << " elements in a tree of height " << this->root->height << std::endl;
+            sout << "Root node at " << this->root.get() << std::endl;
+        }
+        else {
+            sout << "This list is empty" << std::endl;
+        }
+        return sout.str();
+    }
+
+};
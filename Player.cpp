@@ -12,9 +12,10 @@ Player::Player() {
     this->characterName = "Unnamed Character";
     this->characterAge = 0;
     this->characterDesc = "No description available.";
-    this->playerActions = new List<PlayerActions>();
-    this->playerActions->insertAtEnd(new PlayerActions(PlayerActions::PlayerAction::DoNothing));
-    this->playerActions->insertAtEnd(new PlayerActions(PlayerActions::PlayerAction::DoAnything));
+    this->playerActions = new ValueList<PlayerActions>({
+        PlayerActions(PlayerActions::PlayerAction::DoNothing),
+        PlayerActions(PlayerActions::PlayerAction::DoAnything)
+    });
 }
 
 /*
@@ -33,9 +34,14 @@ Player::Player(std::string playerName, std::string characterName, int age) {
         this->characterAge = 0;
     }
     this->characterDesc = "No description available.";
-    this->playerActions = new List<PlayerActions>();
-    this->playerActions->insertAtEnd(new PlayerActions(PlayerActions::PlayerAction::DoNothing));
-    this->playerActions->insertAtEnd(new PlayerActions(PlayerActions::PlayerAction::DoAnything));
+    this->playerActions = new ValueList<PlayerActions>({
+        PlayerActions(PlayerActions::PlayerAction::DoNothing),
+        PlayerActions(PlayerActions::PlayerAction::DoAnything)
+    });
+}
+
+Player::~Player() {
+    delete this->playerActions;
 }
 
 CharacterTypes Player::getCharacterType() {
@@ -44,7 +50,7 @@ CharacterTypes Player::getCharacterType() {
 }
 
 
-List<PlayerActions>* Player::getPlayerActions() {
+ValueList<PlayerActions>* Player::getPlayerActions() {
     return this->playerActions;
 }
 
@@ -4,7 +4,7 @@
 
 #include "CharacterTypes.h"
 #include "PlayerActions.h"
-#include "List.h"
+#include "ValueList.h"
 
 /*
  This class models a player in our role-playing game.
@@ -24,6 +24,14 @@ public:
      */
     Player(std::string playerName, std::string characterName, int age);
 
+    /*
+     Destroys this player and its list of actions.
+     */
+    virtual ~Player();
+
+    Player(const Player&) = delete;
+    Player& operator=(const Player&) = delete;
+
     /*
     Returns the character type of this player. For the base class Player, the
     character type should be CharacterType::Generic
@@ -40,7 +48,7 @@ public:
     Player, this method returns a list containing two actions: PlayerAction::DoAnything
     and PlayerAction::DoNothing.
     */
-    virtual List<PlayerActions>* getPlayerActions();
+    virtual ValueList<PlayerActions>* getPlayerActions();
 
     /*
     Returns true if and only if this player can perform the specified action.
@@ -105,6 +113,6 @@ protected:
     std::string characterName;
     std::string characterDesc;
     int characterAge;
-    List<PlayerActions>* playerActions;
+    ValueList<PlayerActions>* playerActions;
 
 };
@@ -1,5 +1,57 @@
 #include "PlayerActions.h"
 
+const std::string PlayerActions::actionNames[PlayerActions::numActions] = {
+	"BeMerry",
+	"Bluff",
+	"CastSpell",
+	"Charge",
+	"Chill",
+	"CloseUmbrella",
+	"Cry",
+	"DoAnything",
+	"DoNothing",
+	"Drink",
+	"Eat",
+	"FallInLove",
+	"Fight",
+	"GetAllSnarky",
+	"GetAngry",
+	"GetDrunk",
+	"GetHappy",
+	"GetSad",
+	"GoToSleep",
+	"Help",
+	"Hug",
+	"InviteEveryoneOver",
+	"Kill",
+	"Laugh",
+	"Listen",
+	"Negotiate",
+	"OpenUmbrella",
+	"Ostracize",
+	"PickALock",
+	"PutOnArmor",
+	"Revive",
+	"RideHorse",
+	"RunAway",
+	"RunTowards",
+	"SmileMysteriously",
+	"Surrender",
+	"SwordFight",
+	"TakeOffArmor",
+	"Talk",
+	"TellAJoke",
+	"Threaten",
+	"ThrowSpear",
+	"ThrowKnife",
+	"TipHat",
+	"TipWaitress",
+	"WakeUp",
+	"Walk",
+	"WalkAway",
+	"WalkTowards"
+};
+
 PlayerActions::PlayerActions() {
 	this->theAction = PlayerAction::DoNothing;
 }
@@ -9,21 +61,26 @@ PlayerActions::PlayerActions(PlayerAction action) {
 }
 
 PlayerActions::PlayerActions(std::string actionString) {
-	int matchingK = -1;
-	for (int k = 0; k < 48; k++) {
-		if (this->actionNames[k] == actionString) {
-			matchingK = k;
-			break;
-		}
-	}
-	if (matchingK >= 0) {
-		this->theAction = static_cast<PlayerAction>(matchingK);
+	PlayerAction* match = getActionsByName().get(actionString);
+	if (match != nullptr) {
+		this->theAction = *match;
 	}
 	else {
 		this->theAction = PlayerAction::DoNothing;
 	}
 }
 
+Map<std::string, PlayerActions::PlayerAction>& PlayerActions::getActionsByName() {
+	static Map<std::string, PlayerAction> actionsByName = []() {
+		Map<std::string, PlayerAction> result;
+		result.reserve(numActions);
+		for (int k = 0; k < numActions; k++) {
+			result.put(actionNames[k], static_cast<PlayerAction>(k));
+		}
+		return result;
+	}();
+	return actionsByName;
+}
 
 PlayerActions::PlayerAction PlayerActions::PlayerActions::getAction() {
 	return this->theAction;
@@ -2,6 +2,8 @@
 
 #include <string>
 
+#include "Map.h"
+
 /*
  A wrapped enum representing all types of actions a character in our RPG can
  perform. Most characters only perform a subset of these actions.
@@ -107,58 +109,14 @@ protected:
     PlayerActions::PlayerAction theAction;
 
     /*
-     String representation of the above types.
+     Number of actions, and the names of the actions in enum order.
      */
-    std::string actionNames[48] = {
-        "BeMerry",
-        "Bluff",
-        "CastSpell",
-        "Charge",
-        "Chill",
-        "CloseUmbrella",
-        "Cry",
-        "DoAnything",
-        "DoNothing",
-        "Drink",
-        "Eat",
-        "FallInLove"
-        "Fight",
-        "GetAllSnarky",
-        "GetAngry",
-        "GetDrunk",
-        "GetHappy",
-        "GetSad",
-        "GoToSleep",
-        "Help",
-        "Hug",
-        "InviteEveryoneOver",
-        "Kill",
-        "Laugh",
-        "Listen",
-        "Negotiate",
-        "OpenUmbrella",
-        "Ostracize",
-        "PickALock",
-        "PutOnArmor",
-        "Revive",
-        "RideHorse",
-        "RunAway",
-        "RunTowards",
-        "SmileMysteriously",
-        "Surrender",
-        "SwordFight",
-        "TakeOffArmor",
-        "Talk",
-        "TellAJoke",
-        "Threaten",
-        "ThrowSpear",
-        "ThrowKnife",
-        "TipHat",
-        "TipWaitress",
-        "WakeUp",
-        "Walk",
-        "WalkAway",
-        "WalkTowards"
-    };
+    static const int numActions = 49;
+    static const std::string actionNames[numActions];
+
+    /*
+     Returns the map from action names to actions, built on first use.
+     */
+    static Map<std::string, PlayerAction>& getActionsByName();
 
 };
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <sstream>
+#include <string>
+
+#include "Deque.h"
+
+/*
+ A first-in, first-out queue of data pointers, backed by a Deque. Enqueue
+ and dequeue take amortized O(1) time, and allocate nothing once the queue
+ has reached its working size. For a queue fed from several threads, see
+ MPSCQueue.
+ */
+template <typename T>
+class Queue {
+
+protected:
+
+    /*
+     The elements, from the front of the queue to the back.
+     */
+    Deque<T> items;
+
+public:
+
+    /*
+     Returns true if and only if this queue has no elements.
+     */
+    bool isEmpty() {
+        return this->items.isEmpty();
+    }
+
+    /*
+     Returns the number of elements in this queue.
+     */
+    int getSize() {
+        return this->items.getSize();
+    }
+
+    /*
+     Makes sure this queue can hold the specified number of elements without
+     growing.
+     */
+    void reserve(int numElements) {
+        this->items.reserve(numElements);
+    }
+
+    /*
+     Adds the specified data to the back of this queue.
+     */
+    void enqueue(T* data) {
+        this->items.insertAtEnd(data);
+    }
+
+    /*
+     Removes the element at the front of this queue and returns its data, or
+     returns the null pointer if the queue is empty.
+     */
+    T* dequeue() {
+        return this->items.removeFromStart();
+    }
+
+    /*
+     Returns the data at the front of this queue without removing it, or the
+     null pointer if the queue is empty.
+     */
+    T* peek() {
+        return this->items.peekFront();
+    }
+
+    /*
+     Removes every element from this queue. The data is left alone.
+     */
+    void clear() {
+        this->items.clear();
+    }
+
+    /*
+     Returns a string representation of this queue.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "Queue at " << this << std::endl;
+        if (!this->isEmpty()) {
+            sout << "Queue contains " << this->getSize() << " elements" << std::endl;
+            sout << "Front data at " << this->peek() << std::endl;
+        }
+        else {
+            sout << "This queue is empty" << std::endl;
+        }
+        return sout.str();
+    }
+
+};
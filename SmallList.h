@@ -0,0 +1,366 @@
+#pragma once
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "ListIndex.h"
+
+/*
+ A list of data pointers that keeps its first InlineCapacity elements
+ inside the object itself, and only moves them to a heap array once it
+ grows past that. Short lists therefore allocate nothing, and their
+ elements sit next to whatever holds the list. Past the inline capacity
+ the heap array grows by doubling, like a vector.
+
+ It supports the subset of the List interface used for adjacency lists:
+ appending, positional peek and removal, getIndex (with the same optional
+ hash index as List) and iteration. Like the other lists, it holds
+ pointers to data it does not own.
+ */
+template <typename T, int InlineCapacity>
+class SmallList {
+
+    static_assert(InlineCapacity >= 1, "a small list must hold at least one element inline");
+
+protected:
+
+    /*
+     The inline elements, and the array actually in use: inlineItems until
+     the list spills, then a heap array of the specified capacity.
+     */
+    T* inlineItems[InlineCapacity];
+    T** items;
+    int capacity;
+    int numItems;
+
+    /*
+     Optional hash index from data pointers to positions, used by getIndex.
+     See List::enableIndex.
+     */
+    std::unique_ptr<ListIndex<T>> index;
+    int indexThreshold;
+
+    void invalidateIndex() {
+        if (this->index != nullptr) {
+            this->index->invalidate();
+        }
+    }
+
+    /*
+     Returns true if and only if the elements are in a heap array.
+     */
+    bool isSpilled() const {
+        return this->items != this->inlineItems;
+    }
+
+    /*
+     Moves the elements into a heap array with at least the specified
+     capacity.
+     */
+    void grow(int minimumCapacity) {
+        int newCapacity = this->capacity * 2;
+        while (newCapacity < minimumCapacity) {
+            newCapacity *= 2;
+        }
+        T** newItems = new T*[newCapacity];
+        for (int k = 0; k < this->numItems; k++) {
+            newItems[k] = this->items[k];
+        }
+        if (this->isSpilled()) {
+            delete[] this->items;
+        }
+        this->items = newItems;
+        this->capacity = newCapacity;
+    }
+
+    /*
+     Releases the heap array, if any, and goes back to the inline elements.
+     */
+    void releaseItems() {
+        if (this->isSpilled()) {
+            delete[] this->items;
+        }
+        this->items = this->inlineItems;
+        this->capacity = InlineCapacity;
+        this->numItems = 0;
+    }
+
+    /*
+     Takes over the elements of the specified list, which must be empty
+     here, leaving it empty. A heap array changes hands; inline elements
+     are copied.
+     */
+    void takeItemsFrom(SmallList<T, InlineCapacity>& other) {
+        if (other.isSpilled()) {
+            this->items = other.items;
+            this->capacity = other.capacity;
+        }
+        else {
+            for (int k = 0; k < other.numItems; k++) {
+                this->inlineItems[k] = other.inlineItems[k];
+            }
+        }
+        this->numItems = other.numItems;
+        this->index = std::move(other.index);
+        other.items = other.inlineItems;
+        other.capacity = InlineCapacity;
+        other.numItems = 0;
+    }
+
+public:
+
+    typedef T** Iterator;
+
+    /*
+     Creates an empty list using only its inline elements.
+     */
+    SmallList() {
+        this->items = this->inlineItems;
+        this->capacity = InlineCapacity;
+        this->numItems = 0;
+        this->indexThreshold = -1;
+    }
+
+    /*
+     Creates a list holding the same data pointers as the specified one.
+     Indexing is enabled if it is on the specified list, but the copy builds
+     its own index on first use.
+     */
+    SmallList(const SmallList<T, InlineCapacity>& other) : SmallList() {
+        this->reserve(other.numItems);
+        for (int k = 0; k < other.numItems; k++) {
+            this->items[k] = other.items[k];
+        }
+        this->numItems = other.numItems;
+        this->indexThreshold = other.indexThreshold;
+    }
+
+    /*
+     Creates a list that takes over the elements and index of the specified
+     one, leaving it empty.
+     */
+    SmallList(SmallList<T, InlineCapacity>&& other) : SmallList() {
+        this->takeItemsFrom(other);
+        this->indexThreshold = other.indexThreshold;
+    }
+
+    SmallList<T, InlineCapacity>& operator=(const SmallList<T, InlineCapacity>& other) {
+        if (this != &other) {
+            this->clear();
+            this->reserve(other.numItems);
+            for (int k = 0; k < other.numItems; k++) {
+                this->items[k] = other.items[k];
+            }
+            this->numItems = other.numItems;
+            this->indexThreshold = other.indexThreshold;
+        }
+        return *this;
+    }
+
+    SmallList<T, InlineCapacity>& operator=(SmallList<T, InlineCapacity>&& other) {
+        if (this != &other) {
+            this->clear();
+            this->takeItemsFrom(other);
+            this->indexThreshold = other.indexThreshold;
+        }
+        return *this;
+    }
+
+    /*
+     Releases the heap array, if any. The data is left alone.
+     */
+    ~SmallList() {
+        if (this->isSpilled()) {
+            delete[] this->items;
+        }
+    }
+
+    /*
+     Removes every element from this list and goes back to the inline
+     elements. The data is left alone.
+     */
+    void clear() {
+        this->releaseItems();
+        this->index.reset();
+    }
+
+    /*
+     Makes sure this list can hold the specified number of elements without
+     growing.
+     */
+    void reserve(int numElements) {
+        if (numElements > this->capacity) {
+            this->grow(numElements);
+        }
+    }
+
+    /*
+     Enables the hash index used by getIndex, once this list has at least
+     the specified number of elements. See List::enableIndex.
+     */
+    void enableIndex(int minimumSize = 0) {
+        this->indexThreshold = minimumSize < 0 ? 0 : minimumSize;
+    }
+
+    /*
+     Disables the hash index and releases its memory.
+     */
+    void disableIndex() {
+        this->indexThreshold = -1;
+        this->index.reset();
+    }
+
+    /*
+     Returns true if and only if indexing is enabled for this list.
+     */
+    bool isIndexed() {
+        return this->indexThreshold >= 0;
+    }
+
+    /*
+     Returns true if and only if this list has no elements.
+     */
+    bool isEmpty() {
+        return this->numItems == 0;
+    }
+
+    /*
+     Returns the number of elements in this list.
+     */
+    int getSize() {
+        return this->numItems;
+    }
+
+    /*
+     Returns the number of elements this list can hold without growing.
+     */
+    int getCapacity() {
+        return this->capacity;
+    }
+
+    /*
+     Returns true if and only if the elements are stored inside this object
+     rather than on the heap.
+     */
+    bool isInline() {
+        return !this->isSpilled();
+    }
+
+    /*
+     Returns the data at the specified position, or the null pointer if the
+     position does not exist in this list.
+     */
+    T* peek(int position) {
+        T* result = nullptr;
+        if (position >= 0 && position < this->numItems) {
+            result = this->items[position];
+        }
+        return result;
+    }
+
+    /*
+     Inserts the specified data at the end of this list.
+     */
+    void insertAtEnd(T* data) {
+        if (this->numItems == this->capacity) {
+            this->grow(this->numItems + 1);
+        }
+        this->items[this->numItems] = data;
+        if (this->index != nullptr) {
+            this->index->insertedAtEnd(data, this->numItems);
+        }
+        this->numItems++;
+    }
+
+    /*
+     Removes the element at the specified position, and returns its data.
+     If there is no element in the specified position, this method leaves
+     the list unaltered and returns the null pointer.
+     */
+    T* removeFromPosition(int position) {
+        T* result = nullptr;
+        if (position >= 0 && position < this->numItems) {
+            result = this->items[position];
+            for (int k = position + 1; k < this->numItems; k++) {
+                this->items[k - 1] = this->items[k];
+            }
+            this->numItems--;
+            if (this->index != nullptr) {
+                if (position == this->numItems) {
+                    this->index->removedFromEnd(result);
+                }
+                else {
+                    this->invalidateIndex();
+                }
+            }
+        }
+        return result;
+    }
+
+    /*
+     Removes the last element and returns its data, or returns the null
+     pointer if this list is empty.
+     */
+    T* removeFromEnd() {
+        return this->removeFromPosition(this->numItems - 1);
+    }
+
+    /*
+     Returns the position of the first occurrence of the specified data
+     pointer in this list, or a negative number if it is not in this list.
+     */
+    int getIndex(T* data) {
+        if (this->index == nullptr && this->isIndexed() && this->numItems >= this->indexThreshold) {
+            this->index.reset(new ListIndex<T>());
+        }
+        if (this->index != nullptr) {
+            if (this->index->isStale() && this->index->rebuildDue()) {
+                this->index->rebuild(this->begin(), this->end());
+            }
+            if (!this->index->isStale()) {
+                return this->index->find(data);
+            }
+        }
+        int result = -1;
+        for (int k = 0; k < this->numItems; k++) {
+            if (this->items[k] == data) {
+                result = k;
+                break;
+            }
+        }
+        return result;
+    }
+
+    /*
+     Returns an iterator positioned at the first element of this list.
+     */
+    Iterator begin() {
+        return this->items;
+    }
+
+    /*
+     Returns the past-the-end iterator of this list.
+     */
+    Iterator end() {
+        return this->items + this->numItems;
+    }
+
+    /*
+     Returns a string representation of this list.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "SmallList at " << this << std::endl;
+        if (this->numItems > 0) {
+            sout << "List contains " << this->numItems << " elements" << std::endl;
+            sout << (this->isSpilled() ? "Elements stored on the heap at " : "Elements stored inline at ") << this->items << std::endl;
+        }
+        else {
+            sout << "This list is empty" << std::endl;
+        }
+        return sout.str();
+    }
+
+};
@@ -0,0 +1,499 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <sstream>
+#include <string>
+#include <utility>
+
+/*
+ A list of data pointers kept sorted by the data they point to, in an
+ indexable skip list. Each node links forward on a random number of levels,
+ and each link records how many positions it skips, so finding data by
+ key, inserting, removing and peeking at a position all take O(log n)
+ expected time.
+
+ Compare is a strict weak ordering over T, like std::less<T>. Data that
+ compares equivalent keeps the order it was inserted in. Like the other
+ lists, a sorted list holds pointers to data it does not own. The list
+ does not notice when the data it points to changes: remove the data
+ before changing anything its ordering depends on, and insert it again
+ afterwards.
+ */
+template <typename T, typename Compare = std::less<T>>
+class SortedList {
+
+protected:
+
+    /*
+     The most levels a node can link on. With a quarter of the nodes
+     reaching each next level, this is plenty for any list that fits in
+     memory.
+     */
+    static const int maxLevels = 16;
+
+    struct SkipNode;
+
+    /*
+     A forward link on one level, and the number of positions it moves
+     forward. A null link moves to one past the last position.
+     */
+    struct Link {
+        SkipNode* next;
+        int width;
+    };
+
+    /*
+     A node and its links. Nodes are allocated with exactly as many links as
+     their height, so the array runs past the end of the struct.
+     */
+    struct SkipNode {
+        T* data;
+        int height;
+        Link links[1];
+    };
+
+    /*
+     The head node, which has maxLevels links and no data, the number of
+     levels in use, and the number of elements.
+     */
+    SkipNode* head;
+    int numLevels;
+    int numItems;
+
+    /*
+     State of the generator that picks node heights. It is seeded the same
+     way for every list, so runs are repeatable.
+     */
+    unsigned int randomState;
+
+    Compare less;
+
+    /*
+     Allocates a node with the specified data and number of levels.
+     */
+    static SkipNode* createNode(T* data, int height) {
+        void* memory = ::operator new(sizeof(SkipNode) + (height - 1) * sizeof(Link));
+        SkipNode* node = static_cast<SkipNode*>(memory);
+        node->data = data;
+        node->height = height;
+        for (int k = 0; k < height; k++) {
+            node->links[k].next = nullptr;
+            node->links[k].width = 1;
+        }
+        return node;
+    }
+
+    static void destroyNode(SkipNode* node) {
+        ::operator delete(node);
+    }
+
+    /*
+     Returns the height for a new node: each level after the first is
+     reached with probability one in four.
+     */
+    int randomHeight() {
+        int result = 1;
+        while (result < maxLevels) {
+            // xorshift32
+            this->randomState ^= this->randomState << 13;
+            this->randomState ^= this->randomState >> 17;
+            this->randomState ^= this->randomState << 5;
+            if ((this->randomState & 3) != 0) {
+                break;
+            }
+            result++;
+        }
+        return result;
+    }
+
+    /*
+     Fills update with the last node on each level that comes before the
+     specified position (counting the head as position 0 and the elements
+     from 1), and returns the node at that position.
+     */
+    SkipNode* findByPosition(int target, SkipNode** update) {
+        SkipNode* node = this->head;
+        int position = 0;
+        for (int level = this->numLevels - 1; level >= 0; level--) {
+            while (node->links[level].next != nullptr && position + node->links[level].width < target) {
+                position += node->links[level].width;
+                node = node->links[level].next;
+            }
+            update[level] = node;
+        }
+        return node->links[0].next;
+    }
+
+    /*
+     Finds the node holding the specified data pointer. Fills update with
+     the last node on each level before it, and position with its position
+     (counting from 1). Returns the null pointer if the data is not in this
+     list.
+     */
+    SkipNode* findByData(T* data, SkipNode** update, int& position) {
+        SkipNode* node = this->head;
+        position = 0;
+        for (int level = this->numLevels - 1; level >= 0; level--) {
+            while (node->links[level].next != nullptr && this->less(*node->links[level].next->data, *data)) {
+                position += node->links[level].width;
+                node = node->links[level].next;
+            }
+            update[level] = node;
+        }
+        // walk the run of equivalent data, keeping update in step
+        SkipNode* current = node->links[0].next;
+        position++;
+        while (current != nullptr && current->data != data && !this->less(*data, *current->data)) {
+            for (int level = 0; level < current->height; level++) {
+                update[level] = current;
+            }
+            current = current->links[0].next;
+            position++;
+        }
+        if (current != nullptr && current->data != data) {
+            current = nullptr;
+        }
+        return current;
+    }
+
+    /*
+     Unlinks and frees the specified node, given the last node on each level
+     before it, and returns its data.
+     */
+    T* unlink(SkipNode* node, SkipNode** update) {
+        for (int level = 0; level < this->numLevels; level++) {
+            if (update[level]->links[level].next == node) {
+                update[level]->links[level].width += node->links[level].width - 1;
+                update[level]->links[level].next = node->links[level].next;
+            }
+            else {
+                update[level]->links[level].width--;
+            }
+        }
+        while (this->numLevels > 1 && this->head->links[this->numLevels - 1].next == nullptr) {
+            this->numLevels--;
+        }
+        this->numItems--;
+        T* result = node->data;
+        destroyNode(node);
+        return result;
+    }
+
+public:
+
+    /*
+     A forward iterator over the data of a sorted list, in order.
+     */
+    class Iterator {
+
+    protected:
+
+        SkipNode* node;
+
+    public:
+
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef T** pointer;
+        typedef T* reference;
+
+        Iterator(SkipNode* node) {
+            this->node = node;
+        }
+
+        T* operator*() const {
+            return this->node->data;
+        }
+
+        Iterator& operator++() {
+            this->node = this->node->links[0].next;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator result = *this;
+            this->node = this->node->links[0].next;
+            return result;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return this->node == other.node;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
+        }
+
+    };
+
+    typedef Iterator iterator;
+
+    /*
+     Creates an empty list using the specified ordering.
+     */
+    SortedList(Compare less = Compare()) : less(less) {
+        this->head = createNode(nullptr, maxLevels);
+        this->numLevels = 1;
+        this->numItems = 0;
+        this->randomState = 2463534242u;
+    }
+
+    /*
+     Creates a list holding the same data pointers as the specified one.
+     */
+    SortedList(const SortedList<T, Compare>& other) : SortedList(other.less) {
+        for (SkipNode* node = other.head->links[0].next; node != nullptr; node = node->links[0].next) {
+            this->insert(node->data);
+        }
+    }
+
+    /*
+     Creates a list that takes over the nodes of the specified one, leaving
+     it empty.
+     */
+    SortedList(SortedList<T, Compare>&& other) : SortedList(other.less) {
+        this->swap(other);
+    }
+
+    /*
+     Replaces the contents of this list with a copy of, or the contents of,
+     the specified list.
+     */
+    SortedList<T, Compare>& operator=(SortedList<T, Compare> other) {
+        this->swap(other);
+        return *this;
+    }
+
+    /*
+     Releases the nodes of this list. The data is left alone.
+     */
+    ~SortedList() {
+        this->clear();
+        destroyNode(this->head);
+    }
+
+    /*
+     Exchanges the contents of this list and the specified one.
+     */
+    void swap(SortedList<T, Compare>& other) {
+        std::swap(this->head, other.head);
+        std::swap(this->numLevels, other.numLevels);
+        std::swap(this->numItems, other.numItems);
+        std::swap(this->randomState, other.randomState);
+        std::swap(this->less, other.less);
+    }
+
+    /*
+     Returns true if and only if this list has no elements.
+     */
+    bool isEmpty() {
+        return this->numItems == 0;
+    }
+
+    /*
+     Returns the number of elements in this list.
+     */
+    int getSize() {
+        return this->numItems;
+    }
+
+    /*
+     Inserts the specified data in its sorted place, after any equivalent
+     data already in this list, and returns its position.
+     */
+    int insert(T* data) {
+        SkipNode* update[maxLevels];
+        int positions[maxLevels];
+        SkipNode* node = this->head;
+        int position = 0;
+        for (int level = this->numLevels - 1; level >= 0; level--) {
+            while (node->links[level].next != nullptr && !this->less(*data, *node->links[level].next->data)) {
+                position += node->links[level].width;
+                node = node->links[level].next;
+            }
+            update[level] = node;
+            positions[level] = position;
+        }
+        int height = this->randomHeight();
+        for (int level = this->numLevels; level < height; level++) {
+            // a new level starts with a single link from the head to the end
+            update[level] = this->head;
+            positions[level] = 0;
+            this->head->links[level].next = nullptr;
+            this->head->links[level].width = this->numItems + 1;
+        }
+        if (height > this->numLevels) {
+            this->numLevels = height;
+        }
+        SkipNode* newNode = createNode(data, height);
+        for (int level = 0; level < height; level++) {
+            int skipped = position - positions[level];
+            newNode->links[level].next = update[level]->links[level].next;
+            newNode->links[level].width = update[level]->links[level].width - skipped;
+            update[level]->links[level].next = newNode;
+            update[level]->links[level].width = skipped + 1;
+        }
+        for (int level = height; level < this->numLevels; level++) {
+            update[level]->links[level].width++;
+        }
+        this->numItems++;
+        return position;
+    }
+
+    /*
+     Returns the data at the specified position, or the null pointer if the
+     position does not exist in this list.
+     */
+    T* peek(int position) {
+        T* result = nullptr;
+        if (position >= 0 && position < this->numItems) {
+            SkipNode* update[maxLevels];
+            result = this->findByPosition(position + 1, update)->data;
+        }
+        return result;
+    }
+
+    /*
+     Returns the first data in this list that is equivalent to the specified
+     key, or the null pointer if there is none.
+     */
+    T* find(const T& key) {
+        SkipNode* node = this->head;
+        for (int level = this->numLevels - 1; level >= 0; level--) {
+            while (node->links[level].next != nullptr && this->less(*node->links[level].next->data, key)) {
+                node = node->links[level].next;
+            }
+        }
+        node = node->links[0].next;
+        T* result = nullptr;
+        if (node != nullptr && !this->less(key, *node->data)) {
+            result = node->data;
+        }
+        return result;
+    }
+
+    /*
+     Returns the position of the first data in this list that is not less
+     than the specified key. This is the size of the list if all of its data
+     is less.
+     */
+    int lowerBound(const T& key) {
+        SkipNode* node = this->head;
+        int position = 0;
+        for (int level = this->numLevels - 1; level >= 0; level--) {
+            while (node->links[level].next != nullptr && this->less(*node->links[level].next->data, key)) {
+                position += node->links[level].width;
+                node = node->links[level].next;
+            }
+        }
+        return position;
+    }
+
+    /*
+     Returns the position of the specified data pointer in this list, or a
+     negative number if it is not in this list. Only the data equivalent to
+     it is searched, so it must not have changed since it was inserted.
+     */
+    int getIndex(T* data) {
+        SkipNode* update[maxLevels];
+        int position;
+        SkipNode* node = this->findByData(data, update, position);
+        return node != nullptr ? position - 1 : -1;
+    }
+
+    /*
+     Removes the specified data pointer from this list. Returns true if and
+     only if it was in this list.
+     */
+    bool remove(T* data) {
+        SkipNode* update[maxLevels];
+        int position;
+        SkipNode* node = this->findByData(data, update, position);
+        if (node != nullptr) {
+            this->unlink(node, update);
+        }
+        return node != nullptr;
+    }
+
+    /*
+     Removes the element at the specified position and returns its data. If
+     there is no element in the specified position, leaves the list
+     unaltered and returns the null pointer.
+     */
+    T* removeFromPosition(int position) {
+        T* result = nullptr;
+        if (position >= 0 && position < this->numItems) {
+            SkipNode* update[maxLevels];
+            SkipNode* node = this->findByPosition(position + 1, update);
+            result = this->unlink(node, update);
+        }
+        return result;
+    }
+
+    /*
+     Removes the first element and returns its data, or returns the null
+     pointer if this list is empty.
+     */
+    T* removeFromStart() {
+        return this->removeFromPosition(0);
+    }
+
+    /*
+     Removes the last element and returns its data, or returns the null
+     pointer if this list is empty.
+     */
+    T* removeFromEnd() {
+        return this->removeFromPosition(this->numItems - 1);
+    }
+
+    /*
+     Removes every element from this list. The data is left alone.
+     */
+    void clear() {
+        SkipNode* node = this->head->links[0].next;
+        while (node != nullptr) {
+            SkipNode* next = node->links[0].next;
+            destroyNode(node);
+            node = next;
+        }
+        this->head->links[0].next = nullptr;
+        this->head->links[0].width = 1;
+        this->numLevels = 1;
+        this->numItems = 0;
+    }
+
+    /*
+     Returns an iterator positioned at the first element of this list.
+     */
+    Iterator begin() {
+        return Iterator(this->head->links[0].next);
+    }
+
+    /*
+     Returns the past-the-end iterator of this list.
+     */
+    Iterator end() {
+        return Iterator(nullptr);
+    }
+
+    /*
+     Returns a string representation of this list.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "SortedList at " << this << std::endl;
+        if (this->numItems > 0) {
+            sout << "List contains " << this->numItems << " elements on " << this->numLevels << " levels" << std::endl;
+            sout << "First data at " << this->head->links[0].next->data << std::endl;
+        }
+        else {
+            sout << "This list is empty" << std::endl;
+        }
+        return sout.str();
+    }
+
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <sstream>
+#include <string>
+
+#include "Deque.h"
+
+/*
+ A last-in, first-out stack of data pointers, backed by a Deque. Push and
+ pop take amortized O(1) time, and allocate nothing once the stack has
+ reached its working size.
+ */
+template <typename T>
+class Stack {
+
+protected:
+
+    /*
+     The elements; the top of the stack is the back of the deque.
+     */
+    Deque<T> items;
+
+public:
+
+    /*
+     Returns true if and only if this stack has no elements.
+     */
+    bool isEmpty() {
+        return this->items.isEmpty();
+    }
+
+    /*
+     Returns the number of elements on this stack.
+     */
+    int getSize() {
+        return this->items.getSize();
+    }
+
+    /*
+     Makes sure this stack can hold the specified number of elements without
+     growing.
+     */
+    void reserve(int numElements) {
+        this->items.reserve(numElements);
+    }
+
+    /*
+     Pushes the specified data onto this stack.
+     */
+    void push(T* data) {
+        this->items.insertAtEnd(data);
+    }
+
+    /*
+     Removes the top element of this stack and returns its data, or returns
+     the null pointer if the stack is empty.
+     */
+    T* pop() {
+        return this->items.removeFromEnd();
+    }
+
+    /*
+     Returns the data on top of this stack without removing it, or the null
+     pointer if the stack is empty.
+     */
+    T* peek() {
+        return this->items.peekBack();
+    }
+
+    /*
+     Removes every element from this stack. The data is left alone.
+     */
+    void clear() {
+        this->items.clear();
+    }
+
+    /*
+     Returns a string representation of this stack.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "Stack at " << this << std::endl;
+        if (!this->isEmpty()) {
+            sout << "Stack contains " << this->getSize() << " elements" << std::endl;
+            sout << "Top data at " << this->peek() << std::endl;
+        }
+        else {
+            sout << "This stack is empty" << std::endl;
+        }
+        return sout.str();
+    }
+
+};
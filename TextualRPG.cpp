@@ -2,16 +2,27 @@
 //
 
 #include <iostream>
+#include <string>
 
+#include "ChainTester.h"
 #include "CharacterTypesTester.h"
 #include "GameZero.h"
 #include "GraphTester.h"
+#include "ListBenchmark.h"
+#include "MapTester.h"
 #include "Player.h"
 #include "Paladin.h"
 #include "TestResults.h"
 
-int main()
+int main(int argc, char* argv[])
 {
+    // TextualRPG --benchmark times the List storage policies instead of
+    // starting the game
+    if (argc > 1 && std::string(argv[1]) == "--benchmark") {
+        std::cout << ListBenchmark::runAll(20000);
+        return 0;
+    }
+
     std::cout << "Hello TextualRPG!\n";
 
     Paladin* pal = new Paladin("Marcus", "Sir Whackamole", 38);
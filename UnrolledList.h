@@ -0,0 +1,919 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ListIndex.h"
+#include "ListStorage.h"
+#include "NodeAllocator.h"
+
+/*
+ An unrolled linked list: a doubly-linked chain of chunks, each holding up
+ to ChunkSize data pointers. It has the same interface as the linked List.
+ Compared to one node per element, it makes roughly ChunkSize times fewer
+ allocations and pointer hops, while insertion and removal in the middle
+ still only move the elements of one chunk. splitAfter, append and prepend
+ relink chunks, splitting at most one of them.
+
+ The chunk size sets the trade-off: peek, and the walk to a mid-list edit,
+ cost about n/ChunkSize hops, and the edit then moves at most ChunkSize
+ elements within one chunk. Larger chunks therefore make mid-list edits
+ cheaper until moving elements outweighs the walk.
+
+ Chunks are taken from the slab pool. Use it as
+ List<T, UnrolledStorage<ChunkSize>>, or through the UnrolledList alias.
+ */
+template <typename T, int ChunkSize>
+class List<T, UnrolledStorage<ChunkSize>> {
+
+    static_assert(ChunkSize >= 2, "chunks must hold at least two elements");
+
+protected:
+
+    /*
+     A chunk of the list. Chunks in the list are never empty.
+     */
+    struct Chunk {
+        T* items[ChunkSize];
+        int count;
+        Chunk* nextChunk;
+        Chunk* previousChunk;
+
+        Chunk() {
+            this->count = 0;
+            this->nextChunk = nullptr;
+            this->previousChunk = nullptr;
+        }
+    };
+
+    /*
+     The first and last chunks, and the number of elements in the list.
+     */
+    Chunk* startChunk;
+    Chunk* endChunk;
+    int numItems;
+
+    /*
+     Cursor caching the most recently visited chunk and the position of its
+     first element. The cursor is invalid when cursorChunk is null.
+     */
+    Chunk* cursorChunk;
+    int cursorStart;
+
+    /*
+     Optional hash index from data pointers to positions, used by getIndex.
+     See List::enableIndex.
+     */
+    std::unique_ptr<ListIndex<T>> index;
+    int indexThreshold;
+
+    void invalidateCursor() {
+        this->cursorChunk = nullptr;
+        this->cursorStart = -1;
+    }
+
+    void invalidateIndex() {
+        if (this->index != nullptr) {
+            this->index->invalidate();
+        }
+    }
+
+    /*
+     Creates an empty chunk, and links it into the list after the specified
+     chunk, or at the start if the specified chunk is null.
+     */
+    Chunk* insertChunkAfter(Chunk* chunk) {
+        Chunk* newChunk = PooledNodeAllocator::create<Chunk>();
+        Chunk* next = chunk == nullptr ? this->startChunk : chunk->nextChunk;
+        newChunk->previousChunk = chunk;
+        newChunk->nextChunk = next;
+        if (chunk == nullptr) {
+            this->startChunk = newChunk;
+        }
+        else {
+            chunk->nextChunk = newChunk;
+        }
+        if (next == nullptr) {
+            this->endChunk = newChunk;
+        }
+        else {
+            next->previousChunk = newChunk;
+        }
+        return newChunk;
+    }
+
+    /*
+     Unlinks the specified chunk from the list and releases it.
+     */
+    void removeChunk(Chunk* chunk) {
+        if (chunk->previousChunk == nullptr) {
+            this->startChunk = chunk->nextChunk;
+        }
+        else {
+            chunk->previousChunk->nextChunk = chunk->nextChunk;
+        }
+        if (chunk->nextChunk == nullptr) {
+            this->endChunk = chunk->previousChunk;
+        }
+        else {
+            chunk->nextChunk->previousChunk = chunk->previousChunk;
+        }
+        if (this->cursorChunk == chunk) {
+            this->invalidateCursor();
+        }
+        PooledNodeAllocator::destroy(chunk);
+    }
+
+    /*
+     Moves the elements of the specified chunk from the specified offset on
+     into a new chunk linked in after it.
+     */
+    Chunk* splitChunk(Chunk* chunk, int offset) {
+        Chunk* newChunk = this->insertChunkAfter(chunk);
+        for (int k = offset; k < chunk->count; k++) {
+            newChunk->items[k - offset] = chunk->items[k];
+        }
+        newChunk->count = chunk->count - offset;
+        chunk->count = offset;
+        return newChunk;
+    }
+
+    /*
+     Appends the data of the specified list to this one, in new chunks
+     packed full.
+     */
+    void copyChunksFrom(const List<T, UnrolledStorage<ChunkSize>>& other) {
+        this->reserve(other.numItems);
+        for (Chunk* chunk = other.startChunk; chunk != nullptr; chunk = chunk->nextChunk) {
+            for (int k = 0; k < chunk->count; k++) {
+                this->insertAtEnd(chunk->items[k]);
+            }
+        }
+    }
+
+    /*
+     Moves the chunks and index of the specified list into this one, which
+     must be empty, leaving the specified list empty.
+     */
+    void takeChunksFrom(List<T, UnrolledStorage<ChunkSize>>& other) {
+        this->startChunk = other.startChunk;
+        this->endChunk = other.endChunk;
+        this->numItems = other.numItems;
+        this->cursorChunk = other.cursorChunk;
+        this->cursorStart = other.cursorStart;
+        this->indexThreshold = other.indexThreshold;
+        this->index = std::move(other.index);
+        other.startChunk = nullptr;
+        other.endChunk = nullptr;
+        other.numItems = 0;
+        other.invalidateCursor();
+    }
+
+    /*
+     Reserves chunks for the range [first, last) when its length can be
+     found without consuming it.
+     */
+    template <typename ForwardIterator>
+    void reserveFor(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+        this->reserve(static_cast<int>(std::distance(first, last)));
+    }
+
+    template <typename InputIterator>
+    void reserveFor(InputIterator first, InputIterator last, std::input_iterator_tag) {}
+
+    /*
+     Returns the chunk containing the specified position, which must be
+     valid, and sets offset to the position within that chunk. The walk
+     starts from whichever of the start, the end, or the cursor is closest,
+     and leaves the cursor at the returned chunk.
+     */
+    Chunk* findChunk(int position, int& offset) {
+        int fromStart = position;
+        int fromEnd = this->numItems - 1 - position;
+        int fromCursor = this->numItems;
+        if (this->cursorChunk != nullptr) {
+            fromCursor = position - this->cursorStart;
+            if (fromCursor < 0) {
+                fromCursor = -fromCursor;
+            }
+        }
+        Chunk* chunk;
+        int chunkStart;
+        if (fromCursor <= fromStart && fromCursor <= fromEnd) {
+            chunk = this->cursorChunk;
+            chunkStart = this->cursorStart;
+        }
+        else if (fromStart <= fromEnd) {
+            chunk = this->startChunk;
+            chunkStart = 0;
+        }
+        else {
+            chunk = this->endChunk;
+            chunkStart = this->numItems - chunk->count;
+        }
+        while (position >= chunkStart + chunk->count) {
+            chunkStart += chunk->count;
+            chunk = chunk->nextChunk;
+        }
+        while (position < chunkStart) {
+            chunk = chunk->previousChunk;
+            chunkStart -= chunk->count;
+        }
+        this->cursorChunk = chunk;
+        this->cursorStart = chunkStart;
+        offset = position - chunkStart;
+        return chunk;
+    }
+
+public:
+
+    /*
+     A bidirectional iterator over the elements of an unrolled list.
+     */
+    class Iterator {
+
+    protected:
+
+        List<T, UnrolledStorage<ChunkSize>>* list;
+        Chunk* chunk;
+        int offset;
+
+    public:
+
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef T** pointer;
+        typedef T*& reference;
+
+        Iterator() {
+            this->list = nullptr;
+            this->chunk = nullptr;
+            this->offset = 0;
+        }
+
+        Iterator(List<T, UnrolledStorage<ChunkSize>>* list, Chunk* chunk, int offset) {
+            this->list = list;
+            this->chunk = chunk;
+            this->offset = offset;
+        }
+
+        T*& operator*() const {
+            return this->chunk->items[this->offset];
+        }
+
+        Iterator& operator++() {
+            this->offset++;
+            if (this->offset == this->chunk->count) {
+                this->chunk = this->chunk->nextChunk;
+                this->offset = 0;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator result = *this;
+            ++(*this);
+            return result;
+        }
+
+        Iterator& operator--() {
+            if (this->chunk == nullptr) {
+                this->chunk = this->list->endChunk;
+                this->offset = this->chunk->count - 1;
+            }
+            else if (this->offset == 0) {
+                this->chunk = this->chunk->previousChunk;
+                this->offset = this->chunk->count - 1;
+            }
+            else {
+                this->offset--;
+            }
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator result = *this;
+            --(*this);
+            return result;
+        }
+
+        bool operator==(const Iterator& rhs) const {
+            return this->chunk == rhs.chunk && this->offset == rhs.offset;
+        }
+
+        bool operator!=(const Iterator& rhs) const {
+            return !(*this == rhs);
+        }
+
+    };
+
+    typedef Iterator iterator;
+    typedef std::reverse_iterator<Iterator> ReverseIterator;
+    typedef ReverseIterator reverse_iterator;
+
+    /*
+     Creates an empty list.
+     */
+    List() {
+        this->startChunk = nullptr;
+        this->endChunk = nullptr;
+        this->numItems = 0;
+        this->invalidateCursor();
+        this->indexThreshold = -1;
+    }
+
+    /*
+     Creates a list holding the same data pointers as the specified one, in
+     new chunks. The copy builds its own index on first use.
+     */
+    List(const List<T, UnrolledStorage<ChunkSize>>& other) : List() {
+        this->copyChunksFrom(other);
+        this->indexThreshold = other.indexThreshold;
+    }
+
+    /*
+     Creates a list that takes over the chunks and index of the specified
+     one, leaving it empty.
+     */
+    List(List<T, UnrolledStorage<ChunkSize>>&& other) : List() {
+        this->takeChunksFrom(other);
+    }
+
+    List<T, UnrolledStorage<ChunkSize>>& operator=(const List<T, UnrolledStorage<ChunkSize>>& other) {
+        if (this != &other) {
+            this->clear();
+            this->copyChunksFrom(other);
+            this->indexThreshold = other.indexThreshold;
+        }
+        return *this;
+    }
+
+    List<T, UnrolledStorage<ChunkSize>>& operator=(List<T, UnrolledStorage<ChunkSize>>&& other) {
+        if (this != &other) {
+            this->clear();
+            this->takeChunksFrom(other);
+        }
+        return *this;
+    }
+
+    /*
+     Releases every chunk of this list. The data is left alone.
+     */
+    ~List() {
+        this->clear();
+    }
+
+    /*
+     Removes every element from this list. The data is left alone.
+     */
+    void clear() {
+        Chunk* chunk = this->startChunk;
+        while (chunk != nullptr) {
+            Chunk* nextChunk = chunk->nextChunk;
+            PooledNodeAllocator::destroy(chunk);
+            chunk = nextChunk;
+        }
+        this->startChunk = nullptr;
+        this->endChunk = nullptr;
+        this->numItems = 0;
+        this->invalidateCursor();
+        this->index.reset();
+    }
+
+    /*
+     Creates a list containing the specified data, in order.
+     */
+    List(std::initializer_list<T*> items) : List() {
+        this->insertRange(0, items.begin(), items.end());
+    }
+
+    /*
+     Creates a list containing the data in the range [first, last), in
+     order.
+     */
+    template <typename InputIterator>
+    List(InputIterator first, InputIterator last) : List() {
+        this->insertRange(0, first, last);
+    }
+
+    /*
+     Makes sure chunks for the specified number of further elements can be
+     taken from the pool with at most one system allocation.
+     */
+    void reserve(int numElements) {
+        if (numElements > 0) {
+            PooledNodeAllocator::reserve<Chunk>((numElements + ChunkSize - 1) / ChunkSize + 1);
+        }
+    }
+
+    /*
+     Inserts the data in the range [first, last) into this list, in order,
+     starting at the specified position. Positions are clamped as in
+     insertAtPosition. The range is packed into full chunks, and at most
+     one existing chunk is split to make room for it.
+     */
+    template <typename InputIterator>
+    void insertRange(int position, InputIterator first, InputIterator last) {
+        this->reserveFor(first, last, typename std::iterator_traits<InputIterator>::iterator_category());
+        if (position >= this->numItems) {
+            for (; first != last; ++first) {
+                this->insertAtEnd(*first);
+            }
+        }
+        else {
+            List<T, UnrolledStorage<ChunkSize>>* suffix;
+            if (position <= 0) {
+                // move everything into the suffix
+                suffix = new List<T, UnrolledStorage<ChunkSize>>();
+                suffix->append(this);
+            }
+            else {
+                suffix = this->splitAfter(position - 1);
+            }
+            this->invalidateIndex();
+            for (; first != last; ++first) {
+                this->insertAtEnd(*first);
+            }
+            this->append(suffix);
+            delete suffix;
+        }
+    }
+
+    /*
+     Enables the hash index used by getIndex, once this list has at least
+     the specified number of elements.
+     */
+    void enableIndex(int minimumSize = 0) {
+        this->indexThreshold = minimumSize < 0 ? 0 : minimumSize;
+    }
+
+    /*
+     Disables the hash index and releases its memory.
+     */
+    void disableIndex() {
+        this->indexThreshold = -1;
+        this->index.reset();
+    }
+
+    /*
+     Returns true if and only if indexing is enabled for this list.
+     */
+    bool isIndexed() {
+        return this->indexThreshold >= 0;
+    }
+
+    /*
+     Returns true if and only if this list has no elements.
+     */
+    bool isEmpty() {
+        return this->numItems == 0;
+    }
+
+    /*
+     Returns the number of elements in this list.
+     */
+    int getSize() {
+        return this->numItems;
+    }
+
+    /*
+     Returns the number of chunks in this list.
+     */
+    int getNumChunks() {
+        int result = 0;
+        for (Chunk* chunk = this->startChunk; chunk != nullptr; chunk = chunk->nextChunk) {
+            result++;
+        }
+        return result;
+    }
+
+    /*
+     Returns the data at the specified position of this list, or the null
+     pointer if the position does not exist in this list.
+     */
+    T* peek(int position) {
+        T* result = nullptr;
+        if (position >= 0 && position < this->numItems) {
+            int offset;
+            Chunk* chunk = this->findChunk(position, offset);
+            result = chunk->items[offset];
+        }
+        return result;
+    }
+
+    /*
+     Sets the data in the specified position. If the position does not
+     exist in this list, this method does nothing.
+     */
+    void setData(T* data, int position) {
+        if (position >= 0 && position < this->numItems) {
+            this->invalidateIndex();
+            int offset;
+            Chunk* chunk = this->findChunk(position, offset);
+            chunk->items[offset] = data;
+        }
+    }
+
+    /*
+     Inserts the specified data at the beginning of this list.
+     */
+    void insertAtStart(T* data) {
+        if (this->startChunk == nullptr || this->startChunk->count == ChunkSize) {
+            this->insertChunkAfter(nullptr);
+        }
+        Chunk* chunk = this->startChunk;
+        for (int k = chunk->count; k > 0; k--) {
+            chunk->items[k] = chunk->items[k - 1];
+        }
+        chunk->items[0] = data;
+        chunk->count++;
+        this->numItems++;
+        // every chunk after the first now starts one position later
+        if (this->cursorChunk != nullptr && this->cursorChunk != this->startChunk) {
+            this->cursorStart++;
+        }
+        if (this->index != nullptr) {
+            this->index->insertedAtStart(data);
+        }
+    }
+
+    /*
+     Inserts the specified data at the end of this list.
+     */
+    void insertAtEnd(T* data) {
+        if (this->endChunk == nullptr || this->endChunk->count == ChunkSize) {
+            this->insertChunkAfter(this->endChunk);
+        }
+        this->endChunk->items[this->endChunk->count] = data;
+        this->endChunk->count++;
+        this->numItems++;
+        if (this->index != nullptr) {
+            this->index->insertedAtEnd(data, this->numItems - 1);
+        }
+    }
+
+    /*
+     Removes the first element of this list, and returns its data.
+     */
+    T* removeFromStart() {
+        T* result = nullptr;
+        if (!this->isEmpty()) {
+            Chunk* chunk = this->startChunk;
+            result = chunk->items[0];
+            for (int k = 1; k < chunk->count; k++) {
+                chunk->items[k - 1] = chunk->items[k];
+            }
+            chunk->count--;
+            this->numItems--;
+            if (this->cursorChunk != nullptr && this->cursorChunk != chunk) {
+                this->cursorStart--;
+            }
+            if (chunk->count == 0) {
+                this->removeChunk(chunk);
+            }
+            if (this->index != nullptr) {
+                this->index->removedFromStart(result);
+            }
+        }
+        return result;
+    }
+
+    /*
+     Removes the last element of this list, and returns its data.
+     */
+    T* removeFromEnd() {
+        T* result = nullptr;
+        if (!this->isEmpty()) {
+            Chunk* chunk = this->endChunk;
+            chunk->count--;
+            result = chunk->items[chunk->count];
+            this->numItems--;
+            if (chunk->count == 0) {
+                this->removeChunk(chunk);
+            }
+            if (this->index != nullptr) {
+                this->index->removedFromEnd(result);
+            }
+        }
+        return result;
+    }
+
+    /*
+     Returns the index of the first occurance of the specified data in this
+     list, or a negative number if the data is not in this list.
+     */
+    int getIndex(T* data) {
+        if (this->index == nullptr && this->isIndexed() && this->numItems >= this->indexThreshold) {
+            this->index.reset(new ListIndex<T>());
+        }
+        if (this->index != nullptr) {
+            if (this->index->isStale() && this->index->rebuildDue()) {
+                this->index->rebuild(this->begin(), this->end());
+            }
+            if (!this->index->isStale()) {
+                return this->index->find(data);
+            }
+        }
+        int result = -1;
+        int k = 0;
+        for (T* item : *this) {
+            if (item == data) {
+                result = k;
+                break;
+            }
+            k++;
+        }
+        return result;
+    }
+
+    /*
+     Removes the element at the specified position, and returns its data.
+     If there is no element in the specified position, this method leaves
+     the list unaltered and returns the null pointer.
+     */
+    T* removeFromPosition(int position) {
+        T* result;
+        if (position < 0 || position >= this->numItems) {
+            result = nullptr;
+        }
+        else if (position == 0) {
+            result = this->removeFromStart();
+        }
+        else if (position == this->numItems - 1) {
+            result = this->removeFromEnd();
+        }
+        else {
+            this->invalidateIndex();
+            int offset;
+            Chunk* chunk = this->findChunk(position, offset);
+            result = chunk->items[offset];
+            for (int k = offset + 1; k < chunk->count; k++) {
+                chunk->items[k - 1] = chunk->items[k];
+            }
+            chunk->count--;
+            this->numItems--;
+            this->invalidateCursor();
+            if (chunk->count == 0) {
+                this->removeChunk(chunk);
+            }
+            else if (chunk->count < ChunkSize / 2 && chunk->nextChunk != nullptr
+                && chunk->count + chunk->nextChunk->count <= ChunkSize) {
+                // merge the next chunk into this one to keep chunks full
+                Chunk* next = chunk->nextChunk;
+                for (int k = 0; k < next->count; k++) {
+                    chunk->items[chunk->count + k] = next->items[k];
+                }
+                chunk->count += next->count;
+                this->removeChunk(next);
+            }
+        }
+        return result;
+    }
+
+    /*
+     Inserts the specified data into the list in the specified position.
+     Positions before the start of the list insert at the start, and
+     positions after the end insert at the end.
+     */
+    void insertAtPosition(int position, T* data) {
+        if (position <= 0) {
+            this->insertAtStart(data);
+        }
+        else if (position >= this->numItems) {
+            this->insertAtEnd(data);
+        }
+        else {
+            this->invalidateIndex();
+            int offset;
+            Chunk* chunk = this->findChunk(position, offset);
+            if (chunk->count == ChunkSize) {
+                // split the full chunk in half
+                Chunk* upperHalf = this->splitChunk(chunk, ChunkSize / 2);
+                if (offset >= ChunkSize / 2) {
+                    offset -= ChunkSize / 2;
+                    chunk = upperHalf;
+                }
+            }
+            for (int k = chunk->count; k > offset; k--) {
+                chunk->items[k] = chunk->items[k - 1];
+            }
+            chunk->items[offset] = data;
+            chunk->count++;
+            this->numItems++;
+            this->invalidateCursor();
+        }
+    }
+
+    /*
+     Splits this list after the specified position, removing all elements
+     after that position from this list, and returning them as another list.
+     At most one chunk is split; the rest are relinked.
+     */
+    List<T, UnrolledStorage<ChunkSize>>* splitAfter(int position) {
+        List<T, UnrolledStorage<ChunkSize>>* result = new List<T, UnrolledStorage<ChunkSize>>();
+        if (position >= 0 && position < this->numItems - 1) {
+            this->invalidateIndex();
+            int offset;
+            Chunk* chunk = this->findChunk(position, offset);
+            if (offset < chunk->count - 1) {
+                this->splitChunk(chunk, offset + 1);
+            }
+            // everything after chunk goes to the result
+            result->startChunk = chunk->nextChunk;
+            result->endChunk = this->endChunk;
+            result->numItems = this->numItems - (position + 1);
+            result->startChunk->previousChunk = nullptr;
+            chunk->nextChunk = nullptr;
+            this->endChunk = chunk;
+            this->numItems = position + 1;
+        }
+        return result;
+    }
+
+    /*
+     Appends the elements of the specified list to this one, leaving the
+     specified list empty.
+     */
+    void append(List<T, UnrolledStorage<ChunkSize>>* suffix) {
+        if (!suffix->isEmpty()) {
+            this->invalidateIndex();
+            if (this->isEmpty()) {
+                this->startChunk = suffix->startChunk;
+            }
+            else {
+                this->endChunk->nextChunk = suffix->startChunk;
+                suffix->startChunk->previousChunk = this->endChunk;
+            }
+            this->endChunk = suffix->endChunk;
+            this->numItems += suffix->numItems;
+            suffix->startChunk = nullptr;
+            suffix->endChunk = nullptr;
+            suffix->numItems = 0;
+            suffix->invalidateCursor();
+            suffix->invalidateIndex();
+        }
+    }
+
+    /*
+     Prepends the elements of the specified list to this one, leaving the
+     specified list empty.
+     */
+    void prepend(List<T, UnrolledStorage<ChunkSize>>* prefix) {
+        if (!prefix->isEmpty()) {
+            this->invalidateIndex();
+            if (this->isEmpty()) {
+                this->endChunk = prefix->endChunk;
+            }
+            else {
+                this->startChunk->previousChunk = prefix->endChunk;
+                prefix->endChunk->nextChunk = this->startChunk;
+            }
+            this->startChunk = prefix->startChunk;
+            this->numItems += prefix->numItems;
+            this->cursorStart += prefix->numItems;
+            prefix->startChunk = nullptr;
+            prefix->endChunk = nullptr;
+            prefix->numItems = 0;
+            prefix->invalidateCursor();
+            prefix->invalidateIndex();
+        }
+    }
+
+    /*
+     Removes every element whose data satisfies the specified predicate, a
+     function object taking a T* and returning bool, in a single pass over
+     this list. The remaining elements keep their order. Returns the number
+     of elements removed.
+     */
+    template <typename Predicate>
+    int removeIf(Predicate predicate) {
+        int numRemoved = 0;
+        Chunk* chunk = this->startChunk;
+        while (chunk != nullptr) {
+            Chunk* next = chunk->nextChunk;
+            // compact the survivors to the front of the chunk
+            int kept = 0;
+            for (int k = 0; k < chunk->count; k++) {
+                if (!predicate(chunk->items[k])) {
+                    chunk->items[kept++] = chunk->items[k];
+                }
+            }
+            numRemoved += chunk->count - kept;
+            chunk->count = kept;
+            if (kept == 0) {
+                this->removeChunk(chunk);
+            }
+            chunk = next;
+        }
+        if (numRemoved > 0) {
+            this->numItems -= numRemoved;
+            this->invalidateCursor();
+            this->invalidateIndex();
+        }
+        return numRemoved;
+    }
+
+    /*
+     Removes every occurrence of the specified data pointer from this list
+     in a single pass, and returns the number removed.
+     */
+    int removeAll(T* data) {
+        return this->removeIf([data](T* item) { return item == data; });
+    }
+
+    /*
+     Removes every element whose data does not satisfy the specified
+     predicate in a single pass, and returns the number removed.
+     */
+    template <typename Predicate>
+    int retainIf(Predicate predicate) {
+        return this->removeIf([&predicate](T* item) { return !predicate(item); });
+    }
+
+    /*
+     Sorts this list by the data its elements point to, using the specified
+     ordering over T (a strict weak ordering, like std::less<T>). The sort
+     is stable and takes O(n log n) time. The data pointers are sorted in a
+     temporary array and written back, so the chunks keep their shape.
+     */
+    template <typename Compare>
+    void sort(Compare less) {
+        std::vector<T*> sorted(this->begin(), this->end());
+        std::stable_sort(sorted.begin(), sorted.end(), [&less](T* a, T* b) { return less(*a, *b); });
+        int k = 0;
+        for (Chunk* chunk = this->startChunk; chunk != nullptr; chunk = chunk->nextChunk) {
+            for (int offset = 0; offset < chunk->count; offset++) {
+                chunk->items[offset] = sorted[k++];
+            }
+        }
+        this->invalidateIndex();
+    }
+
+    /*
+     Sorts this list by the data its elements point to, in ascending order.
+     */
+    void sort() {
+        this->sort(std::less<T>());
+    }
+
+    /*
+     Returns an iterator positioned at the first element of this list.
+     */
+    Iterator begin() {
+        return Iterator(this, this->startChunk, 0);
+    }
+
+    /*
+     Returns the past-the-end iterator of this list.
+     */
+    Iterator end() {
+        return Iterator(this, nullptr, 0);
+    }
+
+    /*
+     Returns a reverse iterator positioned at the last element of this list.
+     */
+    ReverseIterator rbegin() {
+        return ReverseIterator(this->end());
+    }
+
+    /*
+     Returns the past-the-start reverse iterator of this list.
+     */
+    ReverseIterator rend() {
+        return ReverseIterator(this->begin());
+    }
+
+    /*
+     Returns a string representation of this list.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "List at " << this << std::endl;
+        if (this->startChunk != nullptr) {
+            sout << "List contains " << this->numItems << " elements in " << this->getNumChunks() << " chunks" << std::endl;
+            sout << "Start chunk at " << this->startChunk << std::endl;
+            sout << "End chunk at " << this->endChunk << std::endl;
+        }
+        else {
+            sout << "This list is empty" << std::endl;
+        }
+        return sout.str();
+    }
+
+};
+
+/*
+ Alias for the unrolled list.
+ */
+template <typename T, int ChunkSize = 16>
+using UnrolledList = List<T, UnrolledStorage<ChunkSize>>;
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <initializer_list>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ A list that owns its elements. Where List<T> manages pointers to data
+ that the caller allocates and frees, ValueList<T> stores the elements
+ themselves in one contiguous buffer, so a list of n elements costs a
+ single allocation and its elements are destroyed with it.
+
+ Elements can be copied or moved in, or constructed in place with the
+ emplace methods. Pointers returned by peek, and iterators, stay valid
+ until the next insertion or removal.
+ */
+template <typename T>
+class ValueList {
+
+protected:
+
+    /*
+     The elements, in list order.
+     */
+    std::vector<T> items;
+
+public:
+
+    typedef typename std::vector<T>::iterator Iterator;
+    typedef Iterator iterator;
+    typedef typename std::vector<T>::reverse_iterator ReverseIterator;
+    typedef ReverseIterator reverse_iterator;
+
+    /*
+     Creates an empty list.
+     */
+    ValueList() {}
+
+    /*
+     Creates a list holding copies of the specified elements, in order.
+     */
+    ValueList(std::initializer_list<T> elements) : items(elements) {}
+
+    /*
+     Creates a list holding copies of the elements in the range
+     [first, last), in order.
+     */
+    template <typename InputIterator>
+    ValueList(InputIterator first, InputIterator last) : items(first, last) {}
+
+    /*
+     Replaces the contents of this list with copies of the specified
+     elements.
+     */
+    void assign(std::initializer_list<T> elements) {
+        this->items.assign(elements);
+    }
+
+    /*
+     Makes room for at least the specified number of elements, so that
+     appending up to that many causes no reallocation.
+     */
+    void reserve(int numElements) {
+        if (numElements > 0) {
+            this->items.reserve(static_cast<std::size_t>(numElements));
+        }
+    }
+
+    /*
+     Returns true if and only if this list has no elements.
+     */
+    bool isEmpty() {
+        return this->items.empty();
+    }
+
+    /*
+     Returns the number of elements in this list.
+     */
+    int getSize() {
+        return static_cast<int>(this->items.size());
+    }
+
+    /*
+     Returns a pointer to the element at the specified position of this
+     list, or the null pointer if the position does not exist in this list.
+     */
+    T* peek(int position) {
+        T* result = nullptr;
+        if (position >= 0 && position < this->getSize()) {
+            result = &this->items[position];
+        }
+        return result;
+    }
+
+    /*
+     Replaces the element in the specified position. If the position does
+     not exist in this list, this method does nothing.
+     */
+    void setData(T element, int position) {
+        if (position >= 0 && position < this->getSize()) {
+            this->items[position] = std::move(element);
+        }
+    }
+
+    /*
+     Inserts the specified element at the beginning of this list.
+     */
+    void insertAtStart(T element) {
+        this->items.insert(this->items.begin(), std::move(element));
+    }
+
+    /*
+     Inserts the specified element at the end of this list.
+     */
+    void insertAtEnd(T element) {
+        this->items.push_back(std::move(element));
+    }
+
+    /*
+     Inserts the specified element into the list in the specified position.
+     Positions before the start of the list insert at the start, and
+     positions after the end insert at the end.
+     */
+    void insertAtPosition(int position, T element) {
+        this->emplaceAtPosition(position, std::move(element));
+    }
+
+    /*
+     Constructs an element at the end of this list from the specified
+     constructor arguments, and returns a pointer to it.
+     */
+    template <typename... Args>
+    T* emplaceAtEnd(Args&&... args) {
+        this->items.emplace_back(std::forward<Args>(args)...);
+        return &this->items.back();
+    }
+
+    /*
+     Constructs an element in the specified position of this list from the
+     specified constructor arguments, and returns a pointer to it. Positions
+     are clamped as in insertAtPosition.
+     */
+    template <typename... Args>
+    T* emplaceAtPosition(int position, Args&&... args) {
+        if (position < 0) {
+            position = 0;
+        }
+        else if (position > this->getSize()) {
+            position = this->getSize();
+        }
+        return &*this->items.emplace(this->items.begin() + position, std::forward<Args>(args)...);
+    }
+
+    /*
+     Removes and destroys the first element of this list. Returns true if
+     and only if there was an element to remove.
+     */
+    bool removeFromStart() {
+        return this->removeFromPosition(0);
+    }
+
+    /*
+     Removes and destroys the last element of this list. Returns true if
+     and only if there was an element to remove.
+     */
+    bool removeFromEnd() {
+        bool result = !this->isEmpty();
+        if (result) {
+            this->items.pop_back();
+        }
+        return result;
+    }
+
+    /*
+     Removes and destroys the element at the specified position. Returns
+     true if and only if there was an element in that position.
+     */
+    bool removeFromPosition(int position) {
+        bool result = position >= 0 && position < this->getSize();
+        if (result) {
+            this->items.erase(this->items.begin() + position);
+        }
+        return result;
+    }
+
+    /*
+     Removes and destroys every element of this list.
+     */
+    void clear() {
+        this->items.clear();
+    }
+
+    /*
+     Returns the index of the first element equal to the specified one, or
+     a negative number if there is no such element.
+     */
+    int getIndex(const T& element) {
+        int result = -1;
+        int sz = this->getSize();
+        for (int k = 0; k < sz; k++) {
+            if (this->items[k] == element) {
+                result = k;
+                break;
+            }
+        }
+        return result;
+    }
+
+    /*
+     Returns an iterator positioned at the first element of this list.
+     */
+    Iterator begin() {
+        return this->items.begin();
+    }
+
+    /*
+     Returns the past-the-end iterator of this list.
+     */
+    Iterator end() {
+        return this->items.end();
+    }
+
+    /*
+     Returns a reverse iterator positioned at the last element of this list.
+     */
+    ReverseIterator rbegin() {
+        return this->items.rbegin();
+    }
+
+    /*
+     Returns the past-the-start reverse iterator of this list.
+     */
+    ReverseIterator rend() {
+        return this->items.rend();
+    }
+
+    /*
+     Returns a string representation of this list.
+     */
+    std::string toString() {
+        std::ostringstream sout;
+        sout << "ValueList at " << this << std::endl;
+        if (!this->items.empty()) {
+            sout << "List contains " << this->items.size() << " elements" << std::endl;
+            sout << "Elements stored at " << this->items.data() << std::endl;
+        }
+        else {
+            sout << "This list is empty" << std::endl;
+        }
+        return sout.str();
+    }
+
+};
@@ -3,15 +3,28 @@
 #include <sstream>
 #include <string>
 
-#include "List.h"
+#include "SmallList.h"
+
+template <typename T>
+class EdgeBase;
+
+template <typename T, typename U>
+class Graph;
 
 /*
  A Vertex is a container that supports multiple previous nodes (called
  incoming vertices) and multiple next nodes (called outgoing vertices).
+
+ A vertex owns its adjacency lists but not its data. Vertices are known to
+ their neighbours by address, so they can't be copied or moved; a
+ destroyed vertex first removes itself from its neighbours' lists.
  */
 template <typename T>
 class Vertex {
 
+    template <typename, typename>
+    friend class Graph;
+
 protected:
 
     /*
@@ -19,15 +32,41 @@ protected:
      */
     T* data;
 
+    /*
+     The ID of this vertex in the graph it belongs to, or -1 if it doesn't
+     belong to one. Set by the graph.
+     */
+    int id;
+
+    /*
+     Number of incoming and of outgoing vertices kept inside the vertex
+     itself. Most rooms have fewer exits than this, so their adjacency lists
+     never touch the heap.
+     */
+    static const int inlineNeighbours = 4;
+
     /*
      List of incoming vertices.
      */
-    List<Vertex<T>>* previousNodes;
+    SmallList<Vertex<T>, inlineNeighbours> previousNodes;
 
     /*
      List of outgoing vertices.
      */
-    List<Vertex<T>>* nextNodes;
+    SmallList<Vertex<T>, inlineNeighbours> nextNodes;
+
+    /*
+     The edges of the graph this vertex belongs to that start at this
+     vertex, in the order the graph added them. The graph owns the edges,
+     and keeps this list so that a vertex's edges can be walked without
+     searching the graph's edge list.
+     */
+    SmallList<EdgeBase<T>, inlineNeighbours> outEdges;
+
+    /*
+     Adjacency lists shorter than this are scanned rather than indexed.
+     */
+    static const int adjacencyIndexThreshold = 16;
 
 public:
 
@@ -36,8 +75,9 @@ public:
      */
     Vertex() {
         this->data = nullptr;
-        this->previousNodes = new List<Vertex<T>>();
-        this->nextNodes = new List<Vertex<T>>();
+        this->id = -1;
+        this->previousNodes.enableIndex(adjacencyIndexThreshold);
+        this->nextNodes.enableIndex(adjacencyIndexThreshold);
     }
 
     /*
@@ -46,8 +86,29 @@ public:
      */
     Vertex(T* data) {
         this->data = data;
-        this->previousNodes = new List<Vertex<T>>();
-        this->nextNodes = new List<Vertex<T>>();
+        this->id = -1;
+        this->previousNodes.enableIndex(adjacencyIndexThreshold);
+        this->nextNodes.enableIndex(adjacencyIndexThreshold);
+    }
+
+    Vertex(const Vertex<T>&) = delete;
+    Vertex<T>& operator=(const Vertex<T>&) = delete;
+
+    /*
+     Removes this vertex from the adjacency lists of its neighbours. The
+     data is left alone.
+     */
+    ~Vertex() {
+        for (Vertex<T>* outVertex : this->nextNodes) {
+            if (outVertex != this) {
+                outVertex->previousNodes.removeFromPosition(outVertex->previousNodes.getIndex(this));
+            }
+        }
+        for (Vertex<T>* inVertex : this->previousNodes) {
+            if (inVertex != this) {
+                inVertex->nextNodes.removeFromPosition(inVertex->nextNodes.getIndex(this));
+            }
+        }
     }
 
     /*
@@ -57,6 +118,14 @@ public:
         return this->data;
     }
 
+    /*
+     Returns the ID of this vertex in the graph it belongs to, which is also
+     its index there, or a negative number if it doesn't belong to a graph.
+     */
+    int getId() {
+        return this->id;
+    }
+
     /*
      Sets the data stored by this node to the specified value.
      */
@@ -68,14 +137,14 @@ public:
      Returns the number of incoming vertices to this one.
      */
     int getInDegree() {
-        return this->previousNodes->getSize();
+        return this->previousNodes.getSize();
     }
 
     /*
      Returns the number of outgoing vertices from this one.
      */
     int getOutDegree() {
-        return this->nextNodes->getSize();
+        return this->nextNodes.getSize();
     }
 
     /*
@@ -83,7 +152,7 @@ public:
      to this one.
      */
     bool hasInVertex(Vertex<T>* vertex) {
-        return this->previousNodes->getIndex(vertex) >= 0;
+        return this->previousNodes.getIndex(vertex) >= 0;
     }
 
     /*
@@ -95,7 +164,7 @@ public:
      the null pointer.
      */
     Vertex<T>* getInVertex(int index) {
-        return this->previousNodes->peek(index);
+        return this->previousNodes.peek(index);
     }
 
     /*
@@ -108,13 +177,13 @@ public:
      one, this method does nothing.
      */
     void addInVertex(Vertex<T>* inVertex) {
-        int ndx = this->previousNodes->getIndex(inVertex);
+        int ndx = this->previousNodes.getIndex(inVertex);
         // if ndx >= 0, outVertex is already an outgoing vertex, so
         // we do nothing. Otherwise, we add the outVertex to our list
         // of outgoing vertices
         if (ndx < 0) {
-            this->previousNodes->insertAtEnd(inVertex);
-            inVertex->nextNodes->insertAtEnd(this);
+            this->previousNodes.insertAtEnd(inVertex);
+            inVertex->nextNodes.insertAtEnd(this);
         }
     }
 
@@ -125,7 +194,7 @@ public:
      Vertex with the specified index, this method returns the null pointer.
      */
     T* removeInVertex(int index) {
-        Vertex<T>* removedVertex = this->previousNodes->removeFromPosition(index);
+        Vertex<T>* removedVertex = this->previousNodes.removeFromPosition(index);
         return removedVertex->data;
     }
 
@@ -134,7 +203,7 @@ public:
      from this one.
      */
     bool hasOutVertex(Vertex<T>* vertex) {
-        return this->nextNodes->getIndex(vertex) >= 0;
+        return this->nextNodes.getIndex(vertex) >= 0;
     }
 
     /*
@@ -146,7 +215,7 @@ public:
      the null pointer.
      */
     Vertex<T>* getOutVertex(int index) {
-        return this->nextNodes->peek(index);
+        return this->nextNodes.peek(index);
     }
 
     /*
@@ -159,13 +228,13 @@ public:
      one, this method does nothing.
      */
     void addOutVertex(Vertex<T>* outVertex) {
-        int ndx = this->nextNodes->getIndex(outVertex);
+        int ndx = this->nextNodes.getIndex(outVertex);
         // if ndx >= 0, outVertex is already an outgoing vertex, so
         // we do nothing. Otherwise, we add the outVertex to our list
         // of outgoing vertices
         if (ndx < 0) {
-            this->nextNodes->insertAtEnd(outVertex);
-            outVertex->previousNodes->insertAtEnd(this);
+            this->nextNodes.insertAtEnd(outVertex);
+            outVertex->previousNodes.insertAtEnd(this);
         }
     }
 
@@ -177,7 +246,7 @@ public:
      pointer.
      */
     T* removeOutVertex(int index) {
-        Vertex<T>* removedVertex = this->nextNodes->removeFromPosition(index);
+        Vertex<T>* removedVertex = this->nextNodes.removeFromPosition(index);
         return removedVertex->data;
     }
 